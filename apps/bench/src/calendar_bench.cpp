@@ -0,0 +1,329 @@
+// Classic priority-queue benchmarks for the event calendar backends.
+//
+// hold:    the calendar is filled with n events, then every operation pops
+//          the earliest event and schedules it again at time + increment,
+//          so the size stays at n (Vaucher & Duval).
+// up_down: n schedules followed by n pops, repeated (Jones), so the
+//          calendar sweeps its whole size range in both directions.
+//
+// The fill spreads the first times over one mean increment, except in the
+// equal_time rows: there every event starts at the same time and, with
+// constant increments, stays in step with the others, as sources with the
+// same period firing together do.
+//
+// Each run reports ns/op, heap bytes held per pending event after the
+// fill and, on Linux when perf events are permitted, last-level cache
+// misses per operation.
+//
+// Usage: calendar_bench [max_size] [ops_per_run]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "sim/event/BinaryHeapCalendar.h"
+#include "sim/event/CalendarQueue.h"
+#include "sim/event/EventCalendar.h"
+#include "sim/event/LadderQueue.h"
+#include "sim/event/TournamentCalendar.h"
+#include "sim/simulator/SimulationConfig.h"
+
+// Live heap bytes, tracked through the global allocation functions. Every
+// block carries its size in a header so unsized deletes can be accounted.
+namespace {
+size_t live_bytes = 0;
+constexpr size_t HEADER = alignof(std::max_align_t);
+}  // namespace
+
+void* operator new(size_t size) {
+  void* block = std::malloc(size + HEADER);
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *static_cast<size_t*>(block) = size;
+  live_bytes += size;
+  return static_cast<char*>(block) + HEADER;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(ptr) - HEADER;
+  live_bytes -= *static_cast<size_t*>(block);
+  std::free(block);
+}
+
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+namespace {
+
+struct Backend {
+  std::string name;
+  CalendarType type;
+};
+
+enum class Increment { Exponential, Uniform, Bimodal, Constant };
+
+struct Distribution {
+  std::string name;
+  Increment type;
+  bool spread_fill;
+};
+
+// All increments have mean 1 so runs are comparable across distributions
+class IncrementGenerator {
+ public:
+  explicit IncrementGenerator(Increment type) : type_(type), rng_(42) {}
+
+  double next() {
+    switch (type_) {
+      case Increment::Exponential:
+        return exponential_(rng_);
+      case Increment::Uniform:
+        return 2.0 * unit_(rng_);
+      case Increment::Bimodal:
+        return unit_(rng_) < 0.9 ? 0.1 * unit_(rng_) : 9.1 + unit_(rng_);
+      case Increment::Constant:
+      default:
+        return 1.0;
+    }
+  }
+
+ private:
+  Increment type_;
+  std::mt19937_64 rng_;
+  std::exponential_distribution<double> exponential_{1.0};
+  std::uniform_real_distribution<double> unit_{0.0, 1.0};
+};
+
+// Hardware cache-miss counter for the calling thread; reports -1 when
+// perf events are unavailable
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+#endif
+  }
+
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+  void start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  int64_t stop() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      int64_t count = 0;
+      if (read(fd_, &count, sizeof(count)) == sizeof(count)) {
+        return count;
+      }
+    }
+#endif
+    return -1;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+struct Result {
+  double ns_per_op;
+  double bytes_per_event;
+  int64_t cache_misses;
+  size_t ops;
+};
+
+double fill_time(double now, size_t index, size_t size,
+                 const Distribution& distribution,
+                 IncrementGenerator& generator) {
+  double spread = distribution.spread_fill ? static_cast<double>(index) /
+                                                 static_cast<double>(size)
+                                           : 0.0;
+  return now + spread + generator.next();
+}
+
+std::unique_ptr<IEventCalendar> make_backend(CalendarType type, size_t size) {
+  switch (type) {
+    case CalendarType::CalendarQueue:
+      return std::make_unique<CalendarQueue>();
+    case CalendarType::LadderQueue:
+      return std::make_unique<LadderQueue>();
+    case CalendarType::Tournament:
+      // One arrival slot per pending event
+      return std::make_unique<TournamentCalendar>(size, 0);
+    case CalendarType::BinaryHeap:
+    default:
+      return std::make_unique<BinaryHeapCalendar>();
+  }
+}
+
+Result run_hold(CalendarType type, const Distribution& distribution,
+                size_t size, size_t ops) {
+  IncrementGenerator generator(distribution.type);
+  size_t bytes_before = live_bytes;
+  EventCalendar calendar(make_backend(type, size));
+  for (size_t i = 0; i < size; ++i) {
+    calendar.schedule(
+        Event(fill_time(0.0, i, size, distribution, generator),
+              EventType::arrival, i));
+  }
+  double bytes = static_cast<double>(live_bytes - bytes_before);
+
+  auto hold = [&]() {
+    Event event = calendar.pop_next();
+    calendar.schedule(Event(event.get_time() + generator.next(),
+                            EventType::arrival, event.get_source_id()));
+  };
+
+  // Let the time distribution of pending events settle before timing
+  for (size_t i = 0, warmup = std::min(size, ops); i < warmup; ++i) {
+    hold();
+  }
+
+  CacheMissCounter misses;
+  misses.start();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < ops; ++i) {
+    hold();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  int64_t miss_count = misses.stop();
+
+  return {std::chrono::duration<double, std::nano>(stop - start).count() /
+              static_cast<double>(ops),
+          bytes / static_cast<double>(size), miss_count, ops};
+}
+
+Result run_up_down(CalendarType type, const Distribution& distribution,
+                   size_t size, size_t ops) {
+  IncrementGenerator generator(distribution.type);
+  size_t bytes_before = live_bytes;
+  size_t bytes_full = 0;
+  EventCalendar calendar(make_backend(type, size));
+  size_t cycles = std::max<size_t>(1, ops / (2 * size));
+  double now = 0.0;
+
+  CacheMissCounter misses;
+  misses.start();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t cycle = 0; cycle < cycles; ++cycle) {
+    for (size_t i = 0; i < size; ++i) {
+      calendar.schedule(Event(fill_time(now, i, size, distribution, generator),
+                              EventType::arrival, i));
+    }
+    bytes_full = std::max(bytes_full, live_bytes - bytes_before);
+    for (size_t i = 0; i < size; ++i) {
+      now = calendar.pop_next().get_time();
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  int64_t miss_count = misses.stop();
+
+  size_t total = cycles * 2 * size;
+  return {std::chrono::duration<double, std::nano>(stop - start).count() /
+              static_cast<double>(total),
+          static_cast<double>(bytes_full) / static_cast<double>(size),
+          miss_count, total};
+}
+
+void print(const std::string& benchmark, const std::string& backend,
+           const std::string& distribution, size_t size,
+           const Result& result) {
+  std::cout << benchmark << ';' << backend << ';' << distribution << ';'
+            << size << ';' << std::fixed << std::setprecision(1)
+            << result.ns_per_op << ';' << result.bytes_per_event << ';';
+  if (result.cache_misses >= 0) {
+    std::cout << std::setprecision(3)
+              << static_cast<double>(result.cache_misses) /
+                     static_cast<double>(result.ops);
+  } else {
+    std::cout << "n/a";
+  }
+  std::cout << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t max_size = 10000000;
+  size_t ops = 1000000;
+  if (argc > 1) {
+    max_size = static_cast<size_t>(std::stoul(argv[1]));
+  }
+  if (argc > 2) {
+    ops = static_cast<size_t>(std::stoul(argv[2]));
+  }
+
+  const std::vector<Backend> backends = {
+      {"binary_heap", CalendarType::BinaryHeap},
+      {"calendar_queue", CalendarType::CalendarQueue},
+      {"ladder_queue", CalendarType::LadderQueue},
+      {"tournament", CalendarType::Tournament},
+  };
+  const std::vector<Distribution> distributions = {
+      {"exponential", Increment::Exponential, true},
+      {"uniform", Increment::Uniform, true},
+      {"bimodal", Increment::Bimodal, true},
+      {"constant", Increment::Constant, true},
+      {"constant_equal_time", Increment::Constant, false},
+  };
+
+  std::cout << "benchmark;backend;distribution;size;ns_per_op;"
+               "bytes_per_event;cache_misses_per_op"
+            << '\n';
+  for (const auto& backend : backends) {
+    for (const auto& distribution : distributions) {
+      for (size_t size = 10; size <= max_size; size *= 10) {
+        print("hold", backend.name, distribution.name, size,
+              run_hold(backend.type, distribution, size, ops));
+        print("up_down", backend.name, distribution.name, size,
+              run_up_down(backend.type, distribution, size, ops));
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Cancellation-heavy calendar workload: every entity keeps a pending
+// "arrival" and a pending "timeout". Each arrival reschedules the entity's
+// timeout (cancel + schedule) and schedules the next arrival, so the
+// calendar sees one pop, one cancel and two schedules per step while the
+// number of live events stays at 2 * entities. A flat ns/step-per-log2(n)
+// column means cancellation keeps the backend within O(log n).
+//
+// Usage: cancel_bench [steps_per_size]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sim/event/EventCalendar.h"
+#include "sim/simulator/ConfigurationManager.h"
+#include "sim/simulator/SimulationConfig.h"
+
+namespace {
+
+struct Backend {
+  std::string name;
+  CalendarType type;
+};
+
+double run(CalendarType type, size_t entities, size_t steps) {
+  SimulationConfig config{};
+  config.calendar_type = type;
+  config.sources.resize(entities);
+  config.devices.resize(entities);
+  EventCalendar calendar(ConfigurationManager::create_event_calendar(config));
+
+  std::mt19937_64 rng(42);
+  std::exponential_distribution<double> next_arrival(1.0);
+  const double timeout = 4.0;
+
+  std::vector<EventHandle> timeouts(entities);
+  for (size_t i = 0; i < entities; ++i) {
+    calendar.schedule(Event(next_arrival(rng), EventType::arrival, i));
+    timeouts[i] = calendar.schedule(
+        Event(timeout + next_arrival(rng), EventType::service_end, i));
+  }
+
+  // Let the pending set reach its steady-state mix of live and cancelled
+  // events before timing
+  size_t warmup = std::max(steps / 10, 4 * entities);
+  std::chrono::steady_clock::time_point start;
+  for (size_t step = 0; step < warmup + steps; ++step) {
+    if (step == warmup) {
+      start = std::chrono::steady_clock::now();
+    }
+    Event event = calendar.pop_next();
+    double now = event.get_time();
+    if (event.get_type() == EventType::arrival) {
+      size_t id = event.get_source_id();
+      timeouts[id] = calendar.reschedule(timeouts[id], now + timeout);
+      calendar.schedule(
+          Event(now + next_arrival(rng), EventType::arrival, id));
+    } else {
+      size_t id = event.get_device_id();
+      timeouts[id] = calendar.schedule(
+          Event(now + timeout, EventType::service_end, id));
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(steps);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t steps = 2000000;
+  if (argc > 1) {
+    steps = static_cast<size_t>(std::stoul(argv[1]));
+  }
+
+  const std::vector<Backend> backends = {
+      {"binary_heap", CalendarType::BinaryHeap},
+      {"calendar_queue", CalendarType::CalendarQueue},
+      {"ladder_queue", CalendarType::LadderQueue},
+      {"tournament", CalendarType::Tournament},
+  };
+
+  std::cout << "backend;pending;ns_per_step;ns_per_step_per_log2n" << '\n';
+  for (const auto& backend : backends) {
+    for (size_t entities = 16; entities <= 1000000; entities *= 4) {
+      double ns = run(backend.type, entities, steps);
+      double log_n = std::log2(static_cast<double>(2 * entities));
+      std::cout << backend.name << ';' << 2 * entities << ';' << std::fixed
+                << std::setprecision(1) << ns << ';' << std::setprecision(2)
+                << ns / log_n << '\n';
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Runs many Simulator instances concurrently and checks that every run
+// reproduces its single-threaded reference bit for bit, including the
+// request ids handed out. Build with -DSIM_ENABLE_TSAN=ON to also have
+// ThreadSanitizer watch for data races between instances.
+//
+// Usage: concurrency_stress [threads] [rounds]
+// Exits non-zero on the first mismatch.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sim/observers/ISimulationObserver.h"
+#include "sim/simulator/SimulationConfig.h"
+#include "sim/simulator/Simulator.h"
+
+namespace {
+
+// Folds every request id and completion into a running hash
+class FingerprintObserver : public ISimulationObserver {
+ public:
+  explicit FingerprintObserver(uint64_t& hash) : hash_(hash) {}
+
+  EventMask get_subscriptions() const override {
+    return {EventKind::Arrival, EventKind::ServiceEnd};
+  }
+
+  void on_arrival(const ArrivalEvent& event) override {
+    mix(event.request_id);
+  }
+
+  void on_service_end(const ServiceEndEvent& event) override {
+    mix(event.request_id);
+    uint64_t bits;
+    std::memcpy(&bits, &event.time_in_system, sizeof(bits));
+    mix(bits);
+  }
+
+ private:
+  void mix(uint64_t value) {
+    hash_ = (hash_ ^ value) * 0x100000001b3ull;
+  }
+
+  uint64_t& hash_;
+};
+
+struct Outcome {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  size_t arrived = 0;
+  size_t refused = 0;
+  size_t completed = 0;
+  double avg_time_in_system = 0.0;
+  double current_time = 0.0;
+
+  bool operator==(const Outcome& other) const {
+    return hash == other.hash && arrived == other.arrived &&
+           refused == other.refused && completed == other.completed &&
+           avg_time_in_system == other.avg_time_in_system &&
+           current_time == other.current_time;
+  }
+};
+
+SimulationConfig make_config(size_t index) {
+  SimulationConfig config{};
+  config.buffer_capacity = 2 + index % 7;
+  config.max_arrivals = 20000;
+  config.seed = static_cast<uint32_t>(1000 + index);
+  config.calendar_type = static_cast<CalendarType>(index % 4);
+  size_t sources = 3 + index % 5;
+  size_t devices = 1 + index % 3;
+  for (size_t i = 0; i < sources; ++i) {
+    config.sources.push_back({i, 1.0 + static_cast<double>(i),
+                              DistributionType::Exponential});
+  }
+  for (size_t j = 0; j < devices; ++j) {
+    config.devices.push_back({j, 0.5, DistributionType::Exponential});
+  }
+  return config;
+}
+
+Outcome run(const SimulationConfig& config) {
+  Outcome outcome;
+  Simulator simulator(config);
+  simulator.add_observer(std::make_unique<FingerprintObserver>(outcome.hash));
+  simulator.run();
+  Metrics metrics = simulator.get_metrics();
+  outcome.arrived = metrics.get_arrived();
+  outcome.refused = metrics.get_refused();
+  outcome.completed = metrics.get_completed();
+  outcome.avg_time_in_system = metrics.get_avg_time_in_system();
+  outcome.current_time = simulator.get_current_time();
+  return outcome;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t num_threads = std::max(2u, std::thread::hardware_concurrency());
+  size_t rounds = 3;
+  if (argc > 1) {
+    num_threads = std::max<size_t>(1, std::stoul(argv[1]));
+  }
+  if (argc > 2) {
+    rounds = std::stoul(argv[2]);
+  }
+
+  const size_t num_configs = 4 * num_threads;
+  std::vector<SimulationConfig> configs;
+  std::vector<Outcome> expected;
+  for (size_t i = 0; i < num_configs; ++i) {
+    configs.push_back(make_config(i));
+    expected.push_back(run(configs.back()));
+  }
+
+  std::atomic<size_t> mismatches{0};
+  for (size_t round = 0; round < rounds; ++round) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < num_threads; ++t) {
+      // Every thread walks all configs from a different offset so the
+      // same configuration runs on several threads at once
+      workers.emplace_back([&, t]() {
+        for (size_t k = 0; k < num_configs; ++k) {
+          size_t index = (k + t * 3 + round) % num_configs;
+          if (!(run(configs[index]) == expected[index])) {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    std::cout << "round " << round + 1 << '/' << rounds << ": "
+              << num_threads << " threads x " << num_configs
+              << " simulations, " << mismatches.load() << " mismatches"
+              << '\n';
+    if (mismatches.load() != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,427 @@
+// Throughput and accuracy of the random variate samplers.
+//
+// throughput: ns per variate drawn through IDistribution::fill() in blocks
+//             the size of the simulator's prefetch block, next to the
+//             closest <random> distribution on the same engine where one
+//             exists.
+// accuracy:   one-sample Kolmogorov-Smirnov test of the samples against
+//             the exact CDF, with the asymptotic p-value, and the sample
+//             mean against the configured mean 1 / intensity.
+// histogram:  load time of a histogram_bins-bin empirical histogram from
+//             the text and the binary format, and its table size. The
+//             empirical rows above sample that histogram.
+// The trace rows replay a trace_records-record trace of exponential
+// intervals and service times, looping where the throughput run outlasts
+// it.
+//
+// Usage: distribution_bench [ks_samples] [throughput_samples]
+//                           [histogram_bins] [trace_records]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sim/simulator/ConfigurationManager.h"
+#include "sim/simulator/SimulationConfig.h"
+#include "sim/utils/Histogram.h"
+#include "sim/utils/IDistribution.h"
+#include "sim/utils/VariateBlock.h"
+#include "sim/utils/Xoshiro256PlusPlus.h"
+
+namespace {
+
+constexpr double MEAN = 1.0;
+
+struct Case {
+  std::string name;
+  DistributionType type;
+  double shape;
+  std::function<double(double)> cdf;
+  // Draws one variate from the closest <random> equivalent, if any
+  std::function<double(Xoshiro256PlusPlus&)> reference;
+  std::string data_path = {};
+};
+
+// Irregular, multimodal histogram over [0, 10) with uniform bin width and
+// every 1000th bin empty
+struct TestHistogram {
+  explicit TestHistogram(size_t bins) : width(10.0 / bins) {
+    cumulative.push_back(0.0);
+    for (size_t i = 0; i < bins; ++i) {
+      double x = (i + 0.5) * width;
+      double weight =
+          i % 1000 == 999 ? 0.0 : x * std::exp(-x) * (1.2 + std::sin(7.0 * x));
+      weights.push_back(weight);
+      cumulative.push_back(cumulative.back() + weight);
+      moment += weight * x;
+    }
+  }
+
+  double get_mean() const { return moment / cumulative.back(); }
+
+  // CDF after rescaling to mean MEAN, as EmpiricalDistribution does
+  double cdf(double value) const {
+    double x = value * get_mean() / MEAN;
+    if (x <= 0.0) {
+      return 0.0;
+    }
+    auto bin = static_cast<size_t>(x / width);
+    if (bin >= weights.size()) {
+      return 1.0;
+    }
+    double inside = x / width - static_cast<double>(bin);
+    return (cumulative[bin] + weights[bin] * inside) / cumulative.back();
+  }
+
+  void write_text(const std::string& path) const {
+    std::ofstream file(path);
+    file << "lower,upper,weight\n" << std::setprecision(17);
+    for (size_t i = 0; i < weights.size(); ++i) {
+      file << i * width << ',' << (i + 1) * width << ',' << weights[i]
+           << '\n';
+    }
+  }
+
+  void write_binary(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    uint64_t count = weights.size();
+    file.write("SIMHIST1", 8);
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (size_t i = 0; i < weights.size(); ++i) {
+      double bin[3] = {i * width, (i + 1) * width, weights[i]};
+      file.write(reinterpret_cast<const char*>(bin), sizeof(bin));
+    }
+  }
+
+  double width;
+  double moment = 0.0;
+  std::vector<double> weights;
+  std::vector<double> cumulative;
+};
+
+double normal_cdf(double z) {
+  return 0.5 * std::erfc(-z / std::numbers::sqrt2);
+}
+
+double exponential_cdf(double x, double mean) {
+  return x <= 0.0 ? 0.0 : -std::expm1(-x / mean);
+}
+
+// Exponential intervals and service times with mean MEAN, in the
+// TraceDistribution format
+void write_trace(const std::string& path, size_t records) {
+  std::ofstream file(path, std::ios::binary);
+  uint64_t header[2] = {records, 2};
+  file.write("SIMTRAC1", 8);
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  Xoshiro256PlusPlus engine(3);
+  std::exponential_distribution<double> exponential(1.0 / MEAN);
+  double time = 0.0;
+  std::vector<double> buffer;
+  for (size_t i = 0; i < records; ++i) {
+    time += exponential(engine);
+    buffer.push_back(time);
+    buffer.push_back(exponential(engine));
+    if (buffer.size() == 1 << 16 || i + 1 == records) {
+      file.write(reinterpret_cast<const char*>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size() * sizeof(double)));
+      buffer.clear();
+    }
+  }
+}
+
+std::vector<Case> make_cases(const TestHistogram& histogram,
+                             const std::string& histogram_path,
+                             const std::string& trace_path) {
+  std::vector<Case> cases;
+
+  cases.push_back({"exponential", DistributionType::Exponential, 1.0,
+                   [](double x) { return exponential_cdf(x, MEAN); },
+                   [](Xoshiro256PlusPlus& engine) {
+                     static std::exponential_distribution<double> d(1.0 /
+                                                                    MEAN);
+                     return d(engine);
+                   }});
+
+  const int stages = 4;
+  cases.push_back({"erlang_4", DistributionType::Erlang, stages,
+                   [](double x) {
+                     if (x <= 0.0) {
+                       return 0.0;
+                     }
+                     double rate_x = stages * x / MEAN;
+                     double term = 1.0;
+                     double sum = 1.0;
+                     for (int i = 1; i < stages; ++i) {
+                       term *= rate_x / i;
+                       sum += term;
+                     }
+                     return 1.0 - std::exp(-rate_x) * sum;
+                   },
+                   [](Xoshiro256PlusPlus& engine) {
+                     static std::gamma_distribution<double> d(
+                         stages, MEAN / stages);
+                     return d(engine);
+                   }});
+
+  const double scv = 4.0;
+  double p = 0.5 * (1.0 + std::sqrt((scv - 1.0) / (scv + 1.0)));
+  double mean1 = MEAN / (2.0 * p);
+  double mean2 = MEAN / (2.0 * (1.0 - p));
+  cases.push_back({"hyperexponential_4", DistributionType::Hyperexponential,
+                   scv,
+                   [=](double x) {
+                     return p * exponential_cdf(x, mean1) +
+                            (1.0 - p) * exponential_cdf(x, mean2);
+                   },
+                   nullptr});
+
+  const double sigma = 0.8;
+  double mu = std::log(MEAN) - 0.5 * sigma * sigma;
+  cases.push_back({"lognormal_0.8", DistributionType::Lognormal, sigma,
+                   [=](double x) {
+                     return x <= 0.0 ? 0.0
+                                     : normal_cdf((std::log(x) - mu) / sigma);
+                   },
+                   [=](Xoshiro256PlusPlus& engine) {
+                     static std::lognormal_distribution<double> d(mu, sigma);
+                     return d(engine);
+                   }});
+
+  const double alpha = 2.5;
+  double minimum = MEAN * (alpha - 1.0) / alpha;
+  cases.push_back({"pareto_2.5", DistributionType::Pareto, alpha,
+                   [=](double x) {
+                     return x <= minimum ? 0.0
+                                         : 1.0 - std::pow(minimum / x, alpha);
+                   },
+                   nullptr});
+
+  const double half_width = 0.5;
+  double low = MEAN * (1.0 - half_width);
+  double high = MEAN * (1.0 + half_width);
+  cases.push_back({"uniform_0.5", DistributionType::Uniform, half_width,
+                   [=](double x) {
+                     return std::clamp((x - low) / (high - low), 0.0, 1.0);
+                   },
+                   [=](Xoshiro256PlusPlus& engine) {
+                     static std::uniform_real_distribution<double> d(low,
+                                                                     high);
+                     return d(engine);
+                   }});
+
+  const double k = 1.5;
+  double scale = MEAN / std::tgamma(1.0 + 1.0 / k);
+  cases.push_back({"weibull_1.5", DistributionType::Weibull, k,
+                   [=](double x) {
+                     return x <= 0.0 ? 0.0
+                                     : -std::expm1(-std::pow(x / scale, k));
+                   },
+                   [=](Xoshiro256PlusPlus& engine) {
+                     static std::weibull_distribution<double> d(k, scale);
+                     return d(engine);
+                   }});
+
+  const double cv = 0.5;
+  double z = 1.0 / cv;
+  double density = std::exp(-0.5 * z * z) / std::sqrt(2.0 * std::numbers::pi);
+  double location = MEAN / (1.0 + cv * density / normal_cdf(z));
+  double deviation = cv * location;
+  double below_zero = normal_cdf(-location / deviation);
+  cases.push_back({"truncated_normal_0.5", DistributionType::TruncatedNormal,
+                   cv,
+                   [=](double x) {
+                     if (x <= 0.0) {
+                       return 0.0;
+                     }
+                     return (normal_cdf((x - location) / deviation) -
+                             below_zero) /
+                            (1.0 - below_zero);
+                   },
+                   [=](Xoshiro256PlusPlus& engine) {
+                     static std::normal_distribution<double> d(location,
+                                                               deviation);
+                     double value;
+                     do {
+                       value = d(engine);
+                     } while (value <= 0.0);
+                     return value;
+                   }});
+
+  cases.push_back({"empirical", DistributionType::Empirical, 1.0,
+                   [&histogram](double x) { return histogram.cdf(x); },
+                   nullptr, histogram_path});
+
+  cases.push_back({"trace_intervals", DistributionType::TraceIntervals, 1.0,
+                   [](double x) { return exponential_cdf(x, MEAN); }, nullptr,
+                   trace_path});
+  cases.push_back({"trace_service_times", DistributionType::TraceServiceTimes,
+                   1.0, [](double x) { return exponential_cdf(x, MEAN); },
+                   nullptr, trace_path});
+
+  return cases;
+}
+
+std::unique_ptr<IDistribution> make_distribution(const Case& c,
+                                                 uint32_t seed) {
+  StreamId stream{seed, 0, StreamKind::Source, 0};
+  // The throughput runs outlast the trace
+  bool loop = true;
+  return ConfigurationManager::create_distribution(
+      c.type, 1.0 / MEAN, c.shape, stream, RngType::Xoshiro256PlusPlus,
+      c.data_path, loop);
+}
+
+double ns_per_variate(const Case& c, size_t samples) {
+  auto distribution = make_distribution(c, 1);
+  VariateBlock block;
+  double sink = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < samples; ++i) {
+    sink += block.next(*distribution);
+  }
+  auto end = std::chrono::steady_clock::now();
+  volatile double keep = sink;
+  (void)keep;
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         static_cast<double>(samples);
+}
+
+double reference_ns_per_variate(const Case& c, size_t samples) {
+  Xoshiro256PlusPlus engine(1);
+  double sink = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < samples; ++i) {
+    sink += c.reference(engine);
+  }
+  auto end = std::chrono::steady_clock::now();
+  volatile double keep = sink;
+  (void)keep;
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         static_cast<double>(samples);
+}
+
+// Asymptotic Kolmogorov distribution, P(sqrt(n) D > lambda)
+double ks_p_value(double lambda) {
+  if (lambda < 0.2) {
+    return 1.0;
+  }
+  double sum = 0.0;
+  for (int k = 1; k <= 100; ++k) {
+    double term = std::exp(-2.0 * k * k * lambda * lambda);
+    sum += (k % 2 == 1 ? term : -term);
+    if (term < 1e-16) {
+      break;
+    }
+  }
+  return std::clamp(2.0 * sum, 0.0, 1.0);
+}
+
+struct Accuracy {
+  double ks_statistic;
+  double p_value;
+  double sample_mean;
+};
+
+Accuracy measure_accuracy(const Case& c, size_t samples) {
+  auto distribution = make_distribution(c, 2);
+  std::vector<double> values(samples);
+  distribution->fill(values);
+
+  double sum = 0.0;
+  for (double value : values) {
+    sum += value;
+  }
+  std::sort(values.begin(), values.end());
+
+  double d = 0.0;
+  double n = static_cast<double>(samples);
+  for (size_t i = 0; i < samples; ++i) {
+    double f = c.cdf(values[i]);
+    d = std::max({d, f - static_cast<double>(i) / n,
+                  static_cast<double>(i + 1) / n - f});
+  }
+  return {d, ks_p_value(std::sqrt(n) * d), sum / n};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t ks_samples = 1000000;
+  size_t throughput_samples = 20000000;
+  if (argc > 1) {
+    ks_samples = static_cast<size_t>(std::stoul(argv[1]));
+  }
+  if (argc > 2) {
+    throughput_samples = static_cast<size_t>(std::stoul(argv[2]));
+  }
+  size_t histogram_bins = 1000000;
+  if (argc > 3) {
+    histogram_bins = static_cast<size_t>(std::stoul(argv[3]));
+  }
+  size_t trace_records = 4000000;
+  if (argc > 4) {
+    trace_records = static_cast<size_t>(std::stoul(argv[4]));
+  }
+
+  TestHistogram histogram(histogram_bins);
+  auto directory = std::filesystem::temp_directory_path();
+  std::string text_path = (directory / "distribution_bench.csv").string();
+  std::string binary_path = (directory / "distribution_bench.hist").string();
+  histogram.write_text(text_path);
+  histogram.write_binary(binary_path);
+  std::string trace_path = (directory / "distribution_bench.trace").string();
+  write_trace(trace_path, trace_records);
+
+  std::cout << "distribution;ns_per_variate;random_ns_per_variate;"
+               "ks_statistic;ks_p_value;sample_mean;mean"
+            << '\n';
+  for (const auto& c : make_cases(histogram, binary_path, trace_path)) {
+    double ns = ns_per_variate(c, throughput_samples);
+    Accuracy accuracy = measure_accuracy(c, ks_samples);
+
+    std::cout << c.name << ';' << std::fixed << std::setprecision(2) << ns
+              << ';';
+    if (c.reference) {
+      std::cout << reference_ns_per_variate(c, throughput_samples);
+    } else {
+      std::cout << "n/a";
+    }
+    std::cout << ';' << std::setprecision(6) << accuracy.ks_statistic << ';'
+              << std::setprecision(4) << accuracy.p_value << ';'
+              << std::setprecision(5) << accuracy.sample_mean << ';' << MEAN
+              << '\n';
+  }
+
+  std::cout << '\n' << "histogram_format;bins;load_ms;table_bytes" << '\n';
+  for (const auto& [format, path] :
+       {std::pair<std::string, std::string>{"text", text_path},
+        std::pair<std::string, std::string>{"binary", binary_path}}) {
+    auto start = std::chrono::steady_clock::now();
+    Histogram loaded = Histogram::read(path);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << format << ';' << loaded.get_size() << ';'
+              << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(end - start).count()
+              << ';' << loaded.get_memory_bytes() << '\n';
+  }
+
+  std::remove(text_path.c_str());
+  std::remove(binary_path.c_str());
+  std::remove(trace_path.c_str());
+  return 0;
+}
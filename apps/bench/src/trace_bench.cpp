@@ -0,0 +1,309 @@
+// Cost of tracing a run with EventTraceObserver, and of reading it back.
+//
+// write:  the same run without and with the trace observer, the best of
+//         three alternating runs each, added to the Simulator at run time
+//         and given to BasicSimulator as a static observer. Reports wall
+//         time and, on Linux, the CPU time of the simulating thread, which
+//         leaves out the trace's writer thread, and whether there is one
+//         (thread) or the simulating thread writes the trace (inline, on a
+//         single core). Both include opening and finishing the trace; the
+//         trace file is removed beforehand.
+// verify: the records read back against the events of a traced run,
+//         compared by count and by a hash of every field; a mismatch
+//         fails the benchmark.
+// read:   records per second decoded front to back, and the mean time of
+//         EventTraceReader::seek_time() to a random time plus reading the
+//         record found.
+//
+// Usage: trace_bench [max_arrivals] [trace_path]
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+#include "sim/device/RoundRobinStrategy.h"
+#include "sim/event/BinaryHeapCalendar.h"
+#include "sim/observers/EventTraceObserver.h"
+#include "sim/queue/SlotRotatingPolicy.h"
+#include "sim/simulator/BasicSimulator.h"
+#include "sim/simulator/SimulationConfig.h"
+#include "sim/simulator/Simulator.h"
+#include "sim/utils/EventTraceReader.h"
+#include "sim/utils/ExponentialDistribution.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Simulator picks the same kernel for make_config()
+template <class... Observers>
+using Kernel = BasicSimulator<BinaryHeapCalendar, SlotRotatingPolicy,
+                              RoundRobinStrategy, ExponentialDistribution,
+                              ExponentialDistribution, false, Observers...>;
+
+double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// CPU seconds of the calling thread; -1 where not available
+double thread_seconds() {
+#ifdef __linux__
+  timespec now;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) * 1e-9;
+  }
+#endif
+  return -1.0;
+}
+
+struct Timing {
+  double wall = 1e300;
+  double cpu = 1e300;
+
+  template <class Run>
+  void keep_best(Run run) {
+    auto start = Clock::now();
+    double cpu_start = thread_seconds();
+    run();
+    double cpu_end = thread_seconds();
+    wall = std::min(wall, seconds_since(start));
+    cpu = cpu_start < 0.0 ? -1.0 : std::min(cpu, cpu_end - cpu_start);
+  }
+};
+
+// Order-dependent hash of the fields EventTraceObserver keeps
+class RecordHash {
+ public:
+  void add(EventKind kind, double time, size_t request_id, size_t source_id,
+           size_t device_id, size_t buffer_slot) {
+    mix(static_cast<uint64_t>(kind));
+    mix(std::bit_cast<uint64_t>(time));
+    mix(request_id);
+    mix(source_id);
+    mix(device_id);
+    mix(buffer_slot);
+    ++count_;
+  }
+  void add(const TraceRecord& record) {
+    add(record.kind, record.time, record.request_id, record.source_id,
+        record.device_id, record.buffer_slot);
+  }
+
+  uint64_t get_value() const { return value_; }
+  uint64_t get_count() const { return count_; }
+
+ private:
+  // FNV-1a over the value's bytes
+  void mix(uint64_t value) {
+    for (int i = 0; i < 8; ++i, value >>= 8) {
+      value_ = (value_ ^ (value & 0xff)) * 0x100000001b3;
+    }
+  }
+
+  uint64_t value_ = 0xcbf29ce484222325;
+  uint64_t count_ = 0;
+};
+
+// Hashes the events a trace should hold, taken from the events themselves
+// rather than from EventTraceObserver's conversion
+class HashObserver final : public ISimulationObserver {
+ public:
+  explicit HashObserver(RecordHash& hash) : hash_(hash) {}
+
+  EventMask get_subscriptions() const override {
+    return EventTraceObserver::SUBSCRIPTIONS;
+  }
+  void on_arrival(const ArrivalEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id, 0,
+              0);
+  }
+  void on_service_start(const ServiceStartEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id,
+              event.device_id, 0);
+  }
+  void on_service_end(const ServiceEndEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id,
+              event.device_id, 0);
+  }
+  void on_buffer_place(const BufferPlaceEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id, 0,
+              event.buffer_slot);
+  }
+  void on_buffer_take(const BufferTakeEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id,
+              event.device_id, event.buffer_slot);
+  }
+  void on_buffer_displaced(const BufferDisplacedEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id, 0,
+              0);
+  }
+  void on_refusal(const RefusalEvent& event) override {
+    hash_.add(event.KIND, event.time, event.request_id, event.source_id, 0,
+              0);
+  }
+
+ private:
+  RecordHash& hash_;
+};
+
+SimulationConfig make_config(size_t max_arrivals) {
+  SimulationConfig config{};
+  config.buffer_capacity = 16;
+  config.max_arrivals = max_arrivals;
+  config.seed = 2024;
+  for (size_t i = 0; i < 8; ++i) {
+    config.sources.push_back({i, 0.25, DistributionType::Exponential});
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    config.devices.push_back({i, 0.45, DistributionType::Exponential});
+  }
+  return config;
+}
+
+// One run, traced to path by a run-time observer unless path is empty.
+// The simulator, and with it the observer, is gone before the clock stops,
+// so the trace is complete.
+void run_dynamic(const SimulationConfig& config, const std::string& path,
+                 uint64_t& events) {
+  Simulator simulator(config);
+  if (!path.empty()) {
+    simulator.add_observer(std::make_unique<EventTraceObserver>(path));
+  }
+  simulator.run();
+  events = simulator.get_event_count();
+}
+
+void run_static(const SimulationConfig& config, const std::string& path) {
+  Kernel<EventTraceObserver> simulator(config);
+  auto& trace = simulator.get_observer<EventTraceObserver>();
+  trace.open(path);
+  simulator.run();
+  trace.finish();
+}
+
+void run_untraced_static(const SimulationConfig& config) {
+  Kernel<> simulator(config);
+  simulator.run();
+}
+
+void print_write(const char* observer, uint64_t events, const Timing& plain,
+                 const Timing& traced, const std::string& path) {
+  EventTraceReader reader(path);
+  auto bytes = static_cast<double>(std::filesystem::file_size(path));
+  std::cout << "write;" << observer << ';'
+            << (EventTraceObserver::has_writer_thread() ? "thread" : "inline")
+            << ';' << events << ';' << plain.wall
+            << ';' << traced.wall << ';'
+            << (traced.wall / plain.wall - 1.0) * 100.0 << ';';
+  if (plain.cpu < 0.0) {
+    std::cout << "n/a;n/a;n/a;";
+  } else {
+    std::cout << plain.cpu << ';' << traced.cpu << ';'
+              << (traced.cpu / plain.cpu - 1.0) * 100.0 << ';';
+  }
+  std::cout << reader.get_record_count() << ';'
+            << bytes / static_cast<double>(reader.get_record_count()) << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t max_arrivals = argc > 1 ? std::stoul(argv[1]) : 5000000;
+  std::string path =
+      argc > 2 ? argv[2]
+               : (std::filesystem::temp_directory_path() / "trace_bench.evt")
+                     .string();
+  SimulationConfig config = make_config(max_arrivals);
+
+  uint64_t events = 0;
+  Timing plain;
+  Timing traced;
+  Timing plain_static;
+  Timing traced_static;
+  for (int i = 0; i < 3; ++i) {
+    plain.keep_best([&] { run_dynamic(config, {}, events); });
+    std::filesystem::remove(path);
+    traced.keep_best([&] { run_dynamic(config, path, events); });
+    plain_static.keep_best([&] { run_untraced_static(config); });
+    std::filesystem::remove(path);
+    traced_static.keep_best([&] { run_static(config, path); });
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "write;observer;writer;calendar_events;plain_s;traced_s;"
+               "slowdown_pct;plain_cpu_s;traced_cpu_s;cpu_slowdown_pct;"
+               "records;bytes_per_record\n";
+  // Both ways write the same trace
+  print_write("dynamic", events, plain, traced, path);
+  print_write("static", events, plain_static, traced_static, path);
+
+  std::filesystem::remove(path);
+  RecordHash expected;
+  {
+    Simulator simulator(config);
+    simulator.add_observer(std::make_unique<EventTraceObserver>(path));
+    simulator.add_observer(std::make_unique<HashObserver>(expected));
+    simulator.run();
+  }
+  {
+    EventTraceReader reader(path);
+    RecordHash actual;
+    auto cursor = reader.seek(0);
+    TraceRecord record;
+    while (cursor.next(record)) {
+      actual.add(record);
+    }
+    bool match = reader.is_complete() &&
+                 actual.get_count() == expected.get_count() &&
+                 actual.get_value() == expected.get_value();
+    std::cout << "verify;events;records;match\n";
+    std::cout << "verify;" << expected.get_count() << ';' << actual.get_count()
+              << ';' << (match ? "yes" : "no") << '\n';
+    if (!match) {
+      std::cerr << "trace_bench: the trace does not hold the events\n";
+      std::filesystem::remove(path);
+      return 1;
+    }
+  }
+
+  EventTraceReader reader(path);
+  auto start = Clock::now();
+  auto cursor = reader.seek(0);
+  TraceRecord record;
+  double last_time = 0.0;
+  while (cursor.next(record)) {
+    last_time = record.time;
+  }
+  double scan = seconds_since(start);
+
+  constexpr int SEEKS = 10000;
+  std::mt19937_64 engine(7);
+  std::uniform_real_distribution<double> time(0.0, last_time);
+  size_t found = 0;
+  start = Clock::now();
+  for (int i = 0; i < SEEKS; ++i) {
+    found += reader.seek_time(time(engine)).next(record) ? 1 : 0;
+  }
+  double seek = seconds_since(start);
+
+  std::cout << "read;records_per_s;seek_us;seeks_found\n";
+  std::cout << "read;" << std::setprecision(0)
+            << static_cast<double>(reader.get_record_count()) / scan << ';'
+            << std::setprecision(3) << seek / SEEKS * 1e6 << ';' << found
+            << '\n';
+
+  std::filesystem::remove(path);
+  return 0;
+}
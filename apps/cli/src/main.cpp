@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 #include "sim/metrics/Metrics.h"
 #include "sim/simulator/Simulator.h"
@@ -21,9 +25,11 @@ void print_state(const Simulator& simulator) {
       std::cout << "  Device " << i << ": "
                 << (devices[i]->is_free() ? "FREE" : "BUSY");
       if (!devices[i]->is_free()) {
-        auto request = devices[i]->get_current_request();
-        if (request) {
-          std::cout << " (request " << request->get_id() << ")";
+        RequestHandle request = devices[i]->get_current_request();
+        if (request != NO_REQUEST) {
+          std::cout << " (request "
+                    << simulator.get_request_pool().get(request).get_id()
+                    << ")";
         }
       }
       std::cout << std::endl;
@@ -39,11 +45,73 @@ void print_state(const Simulator& simulator) {
   std::cout << "========================\n" << std::endl;
 }
 
+// Events dispatched per second of wall time running the configuration to
+// the end, over repeated runs lasting at least 0.05 s in total
+double measure_window(Simulator& simulator, uint64_t seed) {
+  uint64_t events = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed{};
+  do {
+    simulator.reset(seed);
+    simulator.run();
+    events += simulator.get_event_count();
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed.count() < 0.05);
+  return static_cast<double>(events) / elapsed.count();
+}
+
+double median(std::vector<double> values) {
+  auto middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  return *middle;
+}
+
+struct Throughput {
+  double headless;  // events/sec
+  double observed;
+  double speedup;
+};
+
+// Medians over WINDOWS pairs of measure_window(), headless and observed
+// alternating and taking turns to go first, after a warm-up window each.
+// The speedup is the median of the pairs' ratios, which cancels drift in
+// the machine's speed.
+Throughput measure_throughput(SimulationConfig config) {
+  constexpr int WINDOWS = 9;
+  config.headless = true;
+  Simulator headless(config);
+  config.headless = false;
+  Simulator observed(config);
+
+  measure_window(headless, config.seed);
+  measure_window(observed, config.seed);
+  std::vector<double> headless_rates;
+  std::vector<double> observed_rates;
+  std::vector<double> speedups;
+  for (int i = 0; i < WINDOWS; ++i) {
+    double headless_rate = 0.0;
+    double observed_rate = 0.0;
+    if (i % 2 == 0) {
+      headless_rate = measure_window(headless, config.seed);
+      observed_rate = measure_window(observed, config.seed);
+    } else {
+      observed_rate = measure_window(observed, config.seed);
+      headless_rate = measure_window(headless, config.seed);
+    }
+    headless_rates.push_back(headless_rate);
+    observed_rates.push_back(observed_rate);
+    speedups.push_back(headless_rate / observed_rate);
+  }
+  return {median(headless_rates), median(observed_rates), median(speedups)};
+}
+
 auto main() -> int {
   SimulationConfig config;
   config.buffer_capacity = 3;
   config.max_arrivals = 1000;
   config.seed = 52;
+  // Nothing here observes the run beyond its metrics
+  config.headless = true;
 
   // Sources
   config.sources.push_back({0, 3.0, DistributionType::Constant});
@@ -99,5 +167,11 @@ auto main() -> int {
   std::cout << "avg_waiting," << metrics.get_avg_waiting_time() << std::endl;
   std::cout << "avg_service," << metrics.get_avg_service_time() << std::endl;
 
+  Throughput throughput = measure_throughput(config);
+  std::cout << "events," << simulator.get_event_count() << std::endl;
+  std::cout << "events_per_sec_headless," << throughput.headless << std::endl;
+  std::cout << "events_per_sec_observed," << throughput.observed << std::endl;
+  std::cout << "headless_speedup," << throughput.speedup << std::endl;
+
   return 0;
 }
@@ -1,8 +1,16 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <memory>
 
 #include "sim/simulator/SimulationConfig.h"
 #include "sim/simulator/Simulator.h"
@@ -20,6 +28,32 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Each configuration runs on its own Simulator, so they are spread over
+  // worker threads; rows are still written in grid order
+  size_t num_threads = max(1u, thread::hardware_concurrency());
+  if (argc > 2) {
+    try {
+      num_threads = max<size_t>(1, static_cast<size_t>(stoul(argv[2])));
+    } catch (...) {
+      cerr << "Invalid thread count argument, using " << num_threads << endl;
+    }
+  }
+
+  // Metrics are recorded by the headless kernels unless asked otherwise;
+  // --compare runs the sweep both ways and reports the speedup
+  bool observed = false;
+  bool compare = false;
+  if (argc > 3) {
+    string mode = argv[3];
+    if (mode == "--observed") {
+      observed = true;
+    } else if (mode == "--compare") {
+      compare = true;
+    } else {
+      cerr << "Unknown mode " << mode << ", running headless" << endl;
+    }
+  }
+
   // Grid ranges (from report)
   vector<size_t> sensors_range;
   for (size_t n = 4; n <= 20; ++n) sensors_range.push_back(n);
@@ -51,68 +85,143 @@ int main(int argc, char** argv) {
     }
   };
 
-  ofstream out("sweep_results.csv");
-  out << "sensors;interval_ms;devices;device_type;buffer_size;max_arrivals;p_ref;avg_time_ms;utilization;cost;passes" << '\n';
-
-  size_t total_configs = sensors_range.size() * interval_ms_vals.size() * devices_range.size() * device_types.size() * buffer_sizes.size();
-  size_t cfg_count = 0;
-
+  struct Job {
+    size_t sensors;
+    size_t interval_ms;
+    size_t devices;
+    int dtype;
+    size_t buf;
+  };
+  vector<Job> jobs;
   for (auto sensors : sensors_range) {
     for (auto interval_ms : interval_ms_vals) {
       for (auto devices : devices_range) {
         for (auto dtype : device_types) {
           for (auto buf : buffer_sizes) {
-            ++cfg_count;
-            if (cfg_count % 50 == 0 || cfg_count == 1) {
-              cout << "Running config " << cfg_count << " / " << total_configs << "..." << endl;
-            }
-
-            SimulationConfig config;
-            config.buffer_capacity = buf;
-            config.max_arrivals = max_arrivals;
-            config.seed = static_cast<uint32_t>(12345 + cfg_count);
-
-            // sources: equal intervals
-            for (size_t i = 0; i < sensors; ++i) {
-              config.sources.push_back({i, static_cast<double>(interval_ms), DistributionType::Constant});
-            }
-
-            // devices: all of same type (per-report assumption)
-            double mean_ms = type_mean_ms(dtype);
-            double mu = 1.0 / mean_ms; // rate parameter for exponential
-            for (size_t j = 0; j < devices; ++j) {
-              config.devices.push_back({j, mu, DistributionType::Exponential});
-            }
-
-            // Run simulation
-            Simulator sim(config);
-            sim.run();
-
-            auto metrics = sim.get_metrics();
-            double p_ref = metrics.get_refusal_probability();
-            double avg_time = metrics.get_avg_time_in_system();
-
-            // compute average utilization across devices
-            double utilization_sum = 0.0;
-            for (size_t d = 0; d < devices; ++d) {
-              utilization_sum += metrics.get_device_utilization(d, sim.get_current_time());
-            }
-            double avg_util = utilization_sum / static_cast<double>(devices);
-
-            // cost
-            unsigned long device_price = type_price(dtype);
-            unsigned long cost = devices * device_price + (buf / 8) * 800ul;
-
-            bool passes = (p_ref <= 0.10) && (avg_time <= 200.0) && (avg_util >= 0.90);
-
-            out << sensors << ';' << interval_ms << ';' << devices << ';' << dtype << ';' << buf << ';' << max_arrivals << ';'
-                << fixed << setprecision(6) << p_ref << ';' << avg_time << ';' << avg_util << ';' << cost << ';' << (passes ? "yes" : "no") << '\n';
+            jobs.push_back({sensors, interval_ms, devices, dtype, buf});
           }
         }
       }
     }
   }
 
+  size_t total_configs = jobs.size();
+  vector<string> rows(total_configs);
+  atomic<size_t> next_job{0};
+  atomic<size_t> finished{0};
+  atomic<uint64_t> dispatched_events{0};
+  mutex progress_mutex;
+  bool headless = !observed;
+
+  // Each worker keeps one Simulator and reconfigures it for every job
+  auto run_job = [&](size_t index, unique_ptr<Simulator>& sim) {
+    const Job& job = jobs[index];
+    SimulationConfig config;
+    config.headless = headless;
+    config.buffer_capacity = job.buf;
+    config.max_arrivals = max_arrivals;
+    // One seed for the sweep, an independent replication per configuration
+    config.seed = 12345;
+    config.replication = static_cast<uint32_t>(index + 1);
+
+    // sources: equal intervals
+    for (size_t i = 0; i < job.sensors; ++i) {
+      config.sources.push_back({i, static_cast<double>(job.interval_ms), DistributionType::Constant});
+    }
+
+    // devices: all of same type (per-report assumption)
+    double mean_ms = type_mean_ms(job.dtype);
+    double mu = 1.0 / mean_ms; // rate parameter for exponential
+    for (size_t j = 0; j < job.devices; ++j) {
+      config.devices.push_back({j, mu, DistributionType::Exponential});
+    }
+
+    // Run simulation
+    if (sim) {
+      sim->reconfigure(config);
+    } else {
+      sim = make_unique<Simulator>(config);
+    }
+    sim->run();
+    dispatched_events += sim->get_event_count();
+
+    auto metrics = sim->get_metrics();
+    double p_ref = metrics.get_refusal_probability();
+    double avg_time = metrics.get_avg_time_in_system();
+
+    // compute average utilization across devices
+    double utilization_sum = 0.0;
+    for (size_t d = 0; d < job.devices; ++d) {
+      utilization_sum += metrics.get_device_utilization(d, sim->get_current_time());
+    }
+    double avg_util = utilization_sum / static_cast<double>(job.devices);
+
+    // cost
+    unsigned long device_price = type_price(job.dtype);
+    unsigned long cost = job.devices * device_price + (job.buf / 8) * 800ul;
+
+    bool passes = (p_ref <= 0.10) && (avg_time <= 200.0) && (avg_util >= 0.90);
+
+    ostringstream row;
+    row << job.sensors << ';' << job.interval_ms << ';' << job.devices << ';' << job.dtype << ';' << job.buf << ';' << max_arrivals << ';'
+        << fixed << setprecision(6) << p_ref << ';' << avg_time << ';' << avg_util << ';' << cost << ';' << (passes ? "yes" : "no") << '\n';
+    rows[index] = row.str();
+  };
+
+  auto worker = [&]() {
+    unique_ptr<Simulator> sim;
+    for (size_t index = next_job++; index < total_configs; index = next_job++) {
+      run_job(index, sim);
+      size_t done = ++finished;
+      if (done % 50 == 0 || done == 1) {
+        lock_guard<mutex> lock(progress_mutex);
+        cout << "Finished config " << done << " / " << total_configs << "..." << endl;
+      }
+    }
+  };
+
+  // Returns the events dispatched per second of wall time
+  auto run_sweep = [&]() {
+    next_job = 0;
+    finished = 0;
+    dispatched_events = 0;
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (size_t t = 1; t < num_threads; ++t) {
+      workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& w : workers) {
+      w.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double rate = static_cast<double>(dispatched_events) / elapsed.count();
+    cout << (headless ? "Headless" : "Observed") << " sweep: "
+         << dispatched_events << " events in " << fixed << setprecision(3)
+         << elapsed.count() << " s, " << setprecision(0) << rate
+         << " events/sec" << defaultfloat << endl;
+    return rate;
+  };
+
+  double rate = run_sweep();
+  if (compare) {
+    vector<string> headless_rows = rows;
+    headless = false;
+    double observed_rate = run_sweep();
+    cout << "Headless speedup: " << fixed << setprecision(2)
+         << rate / observed_rate << "x" << defaultfloat << endl;
+    if (rows != headless_rows) {
+      cerr << "Headless and observed results differ" << endl;
+      return 1;
+    }
+  }
+
+  ofstream out("sweep_results.csv");
+  out << "sensors;interval_ms;devices;device_type;buffer_size;max_arrivals;p_ref;avg_time_ms;utilization;cost;passes" << '\n';
+  for (const auto& row : rows) {
+    out << row;
+  }
+
   out.close();
   cout << "Sweep completed. Results written to sweep_results.csv" << endl;
 
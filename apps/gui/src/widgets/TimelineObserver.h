@@ -19,6 +19,13 @@ class TimelineObserver : public ISimulationObserver {
  public:
   TimelineObserver() = default;
 
+  EventMask get_subscriptions() const override {
+    return {EventKind::Arrival,     EventKind::ServiceStart,
+            EventKind::ServiceEnd,  EventKind::BufferPlace,
+            EventKind::BufferTake,  EventKind::BufferDisplaced,
+            EventKind::Refusal};
+  }
+
   void on_arrival(const ArrivalEvent& event) override;
   void on_service_start(const ServiceStartEvent& event) override;
   void on_service_end(const ServiceEndEvent& event) override;
@@ -1,12 +1,13 @@
 #ifndef SIM_DEVICE_DEVICE_H_
 #define SIM_DEVICE_DEVICE_H_
 
+#include <cmath>
 #include <cstddef>
 #include <memory>
 
+#include "sim/model/RequestPool.h"
 #include "sim/utils/IDistribution.h"
-
-class Request;
+#include "sim/utils/VariateBlock.h"
 
 class Device {
  public:
@@ -14,22 +15,53 @@ class Device {
 
   Device(size_t id, std::unique_ptr<IDistribution> distribution);
 
-  void start_service(std::shared_ptr<Request> request, double now);
-  std::shared_ptr<Request> finish_service();
-  std::shared_ptr<Request> get_current_request() const;
+  RequestHandle get_current_request() const;
 
-  double schedule_next_service_end(double current_time);
+  // Distribution may name the concrete (final) type of the distribution
+  // held, which turns the draw into a direct call. Throws
+  // std::runtime_error on an infinite service time, as an exhausted trace
+  // gives; ConfigurationManager::check_service_traces() rejects traces too
+  // short for the run before it starts.
+  template <class Distribution = IDistribution>
+  double schedule_next_service_end(double current_time) {
+    double service_time =
+        variates_.next<Distribution>(*service_distribution_);
+    if (std::isinf(service_time)) {
+      throw_exhausted();
+    }
+    next_service_end_time_ = current_time + service_time;
+    busy_time_ += service_time;
+    return next_service_end_time_;
+  }
   double get_next_service_end_time() const;
+  // Sum of all service times drawn so far, including the current one
+  double get_busy_time() const;
   void clear_next_service_end_time();
   bool is_free() const;
   size_t get_id() const;
 
+  IDistribution& get_distribution();
+  void set_distribution(std::unique_ptr<IDistribution> distribution);
+  // Returns to the just-constructed state and drops the prefetched
+  // variates; the distribution itself is untouched
+  void reset();
+
  private:
+  // Busy/free transitions go through DevicePool, which keeps its free set
+  // and the selection strategy in step
+  friend class DevicePool;
+
+  [[noreturn]] void throw_exhausted() const;
+  void start_service(RequestHandle request);
+  RequestHandle finish_service();
+
   size_t id_;
   bool busy_;
-  std::shared_ptr<Request> current_request_;
+  RequestHandle current_request_;
   std::unique_ptr<IDistribution> service_distribution_;
+  VariateBlock variates_;
   double next_service_end_time_;
+  double busy_time_;
 };
 
 #endif  // SIM_DEVICE_DEVICE_H_
@@ -8,25 +8,66 @@
 #include "sim/device/Device.h"
 #include "sim/device/IDeviceSelectionStrategy.h"
 #include "sim/utils/IDistribution.h"
+#include "sim/utils/IndexBitmap.h"
 
 class DevicePool {
  public:
   DevicePool(size_t num_devices,
              std::unique_ptr<IDeviceSelectionStrategy> strategy,
              std::vector<std::unique_ptr<IDistribution>> distributions);
+  DevicePool(const DevicePool&) = delete;
+  DevicePool& operator=(const DevicePool&) = delete;
+
+  // Strategy may name the concrete (final) type of the strategy held, which
+  // turns the selection and the transition hooks into direct calls
+  template <class Strategy = IDeviceSelectionStrategy>
+  Device* find_free_device() {
+    return static_cast<Strategy&>(*strategy_).find_free_device(
+        devices_, free_devices_);
+  }
+  template <class Strategy = IDeviceSelectionStrategy>
+  void start_service(Device& device, RequestHandle request) {
+    device.start_service(request);
+    free_devices_.reset(device.get_id());
+    static_cast<Strategy&>(*strategy_).on_device_busy(device);
+  }
+  // Returns the request that was in service, or NO_REQUEST if none
+  template <class Strategy = IDeviceSelectionStrategy>
+  RequestHandle finish_service(Device& device) {
+    RequestHandle request = device.finish_service();
+    if (request != NO_REQUEST) {
+      free_devices_.set(device.get_id());
+      static_cast<Strategy&>(*strategy_).on_device_free(device);
+    }
+    return request;
+  }
 
-  Device* find_free_device();
   Device& get_device(size_t id);
   const Device& get_device(size_t id) const;
   const std::vector<std::unique_ptr<Device>>& get_all_devices() const;
   std::vector<bool> get_device_states() const;
   std::vector<double> get_all_next_event_times() const;
   size_t size() const;
+  void set_strategy(std::unique_ptr<IDeviceSelectionStrategy> strategy);
+  const IDeviceSelectionStrategy& get_strategy() const;
   void reset_strategy();
 
+  // Appends a device; its id must equal the current size()
+  void add_device(std::unique_ptr<Device> device);
+  // Drops the devices with id >= count
+  void truncate(size_t count);
+  // Frees every device and resets the selection strategy
+  void reset();
+
+  // Ids of the devices currently free
+  const IndexBitmap& get_free_devices() const;
+
  private:
+  void rebuild_free_devices();
+
   std::vector<std::unique_ptr<Device>> devices_;
   std::unique_ptr<IDeviceSelectionStrategy> strategy_;
+  IndexBitmap free_devices_;
 };
 
 #endif  // SIM_DEVICE_DEVICE_POOL_H_
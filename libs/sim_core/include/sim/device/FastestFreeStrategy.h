@@ -0,0 +1,31 @@
+#ifndef SIM_DEVICE_FASTEST_FREE_STRATEGY_H_
+#define SIM_DEVICE_FASTEST_FREE_STRATEGY_H_
+
+#include <vector>
+
+#include "sim/device/IDeviceSelectionStrategy.h"
+#include "sim/utils/IndexBitmap.h"
+
+// The free device with the shortest mean service time, lower id on ties.
+// Devices are ranked once by speed and a bitmap over ranks tracks which
+// are free, so a lookup is a single find-first-set.
+class FastestFreeStrategy final : public IDeviceSelectionStrategy {
+ public:
+  // mean_service_times[id] for every device in the pool
+  explicit FastestFreeStrategy(const std::vector<double>& mean_service_times);
+
+  Device* find_free_device(
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) override;
+
+  void on_device_busy(const Device& device) override;
+  void on_device_free(const Device& device) override;
+  void reset() override;
+
+ private:
+  std::vector<size_t> device_at_rank_;
+  std::vector<size_t> rank_of_device_;
+  IndexBitmap free_ranks_;
+};
+
+#endif  // SIM_DEVICE_FASTEST_FREE_STRATEGY_H_
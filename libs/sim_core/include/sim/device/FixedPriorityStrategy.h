@@ -0,0 +1,14 @@
+#ifndef SIM_DEVICE_FIXED_PRIORITY_STRATEGY_H_
+#define SIM_DEVICE_FIXED_PRIORITY_STRATEGY_H_
+
+#include "sim/device/IDeviceSelectionStrategy.h"
+
+// Always the free device with the lowest id
+class FixedPriorityStrategy final : public IDeviceSelectionStrategy {
+ public:
+  Device* find_free_device(
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) override;
+};
+
+#endif  // SIM_DEVICE_FIXED_PRIORITY_STRATEGY_H_
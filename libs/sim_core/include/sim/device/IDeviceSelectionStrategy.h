@@ -6,13 +6,21 @@
 #include <vector>
 
 class Device;
+class IndexBitmap;
 
 class IDeviceSelectionStrategy {
  public:
   virtual ~IDeviceSelectionStrategy() = default;
 
+  // Picks one of the devices whose ids are set in free_devices, or returns
+  // nullptr when none is free
   virtual Device* find_free_device(
-      const std::vector<std::unique_ptr<Device>>& devices) = 0;
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) = 0;
+
+  // Busy/free transitions, for strategies keeping their own index
+  virtual void on_device_busy(const Device& /*device*/) {}
+  virtual void on_device_free(const Device& /*device*/) {}
 
   virtual void reset() {}
 };
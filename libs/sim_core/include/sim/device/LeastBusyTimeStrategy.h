@@ -0,0 +1,36 @@
+#ifndef SIM_DEVICE_LEAST_BUSY_TIME_STRATEGY_H_
+#define SIM_DEVICE_LEAST_BUSY_TIME_STRATEGY_H_
+
+#include <vector>
+
+#include "sim/device/IDeviceSelectionStrategy.h"
+
+// The free device with the least cumulative busy time, lower id on ties.
+// Free devices sit in an indexed binary min-heap keyed by the busy time
+// they had when released, so every transition costs O(log n).
+class LeastBusyTimeStrategy final : public IDeviceSelectionStrategy {
+ public:
+  explicit LeastBusyTimeStrategy(size_t num_devices);
+
+  Device* find_free_device(
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) override;
+
+  void on_device_busy(const Device& device) override;
+  void on_device_free(const Device& device) override;
+  void reset() override;
+
+ private:
+  static constexpr size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+
+  bool less(size_t lhs, size_t rhs) const;
+  void place(size_t position, size_t id);
+  void sift_up(size_t position);
+  void sift_down(size_t position);
+
+  std::vector<size_t> heap_;       // device ids
+  std::vector<size_t> position_;   // heap index per device, or NOT_IN_HEAP
+  std::vector<double> busy_time_;  // heap key per device
+};
+
+#endif  // SIM_DEVICE_LEAST_BUSY_TIME_STRATEGY_H_
@@ -0,0 +1,40 @@
+#ifndef SIM_DEVICE_RANDOM_STRATEGY_H_
+#define SIM_DEVICE_RANDOM_STRATEGY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/device/IDeviceSelectionStrategy.h"
+#include "sim/utils/StreamId.h"
+#include "sim/utils/Xoshiro256PlusPlus.h"
+
+// A free device chosen uniformly at random. Free ids are kept densely
+// packed with a back index, so a pick and every transition are O(1). The
+// index is drawn by a fixed method rather than a standard library
+// distribution, so a seed picks the same devices on every platform.
+class RandomStrategy final : public IDeviceSelectionStrategy {
+ public:
+  RandomStrategy(size_t num_devices, const StreamId& stream);
+
+  Device* find_free_device(
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) override;
+
+  void on_device_busy(const Device& device) override;
+  void on_device_free(const Device& device) override;
+  void reset() override;  // also restarts the random stream
+
+ private:
+  static constexpr size_t NOT_FREE = static_cast<size_t>(-1);
+
+  // Uniform in [0, count), count below 2^32
+  size_t pick(size_t count);
+
+  std::vector<size_t> free_ids_;
+  std::vector<size_t> position_;  // index in free_ids_, or NOT_FREE
+  uint64_t seed_;
+  Xoshiro256PlusPlus rng_;
+};
+
+#endif  // SIM_DEVICE_RANDOM_STRATEGY_H_
@@ -3,12 +3,13 @@
 
 #include "sim/device/IDeviceSelectionStrategy.h"
 
-class RoundRobinStrategy : public IDeviceSelectionStrategy {
+class RoundRobinStrategy final : public IDeviceSelectionStrategy {
  public:
   RoundRobinStrategy() : next_index_(0) {}
 
   Device* find_free_device(
-      const std::vector<std::unique_ptr<Device>>& devices) override;
+      const std::vector<std::unique_ptr<Device>>& devices,
+      const IndexBitmap& free_devices) override;
 
   void reset() override { next_index_ = 0; }
 
@@ -0,0 +1,25 @@
+#ifndef SIM_EVENT_BINARY_HEAP_CALENDAR_H_
+#define SIM_EVENT_BINARY_HEAP_CALENDAR_H_
+
+#include <vector>
+
+#include "sim/event/IEventCalendar.h"
+
+class BinaryHeapCalendar final : public IEventCalendar {
+ public:
+  BinaryHeapCalendar() = default;
+
+  void schedule(const Event& event) override;
+  void schedule_bulk(std::span<const Event> events) override;
+  Event pop_next() override;
+  void pop_batch(std::vector<Event>& batch) override;
+  Event peek_next() const override;
+  size_t get_size() const override;
+  bool is_empty() const override;
+  void clear() override;
+
+ private:
+  std::vector<Event> heap_;
+};
+
+#endif  // SIM_EVENT_BINARY_HEAP_CALENDAR_H_
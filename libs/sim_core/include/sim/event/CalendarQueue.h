@@ -0,0 +1,64 @@
+#ifndef SIM_EVENT_CALENDAR_QUEUE_H_
+#define SIM_EVENT_CALENDAR_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/event/IEventCalendar.h"
+
+// Brown's calendar queue: events are hashed by time into a ring of "days"
+// (buckets of width_ time units). The bucket count follows the number of
+// pending events and the width is re-estimated from the event spacing on each
+// resize, which keeps schedule/pop O(1) amortized for stationary workloads.
+class CalendarQueue final : public IEventCalendar {
+ public:
+  CalendarQueue();
+
+  void schedule(const Event& event) override;
+  void schedule_bulk(std::span<const Event> events) override;
+  Event pop_next() override;
+  void pop_batch(std::vector<Event>& batch) override;
+  Event peek_next() const override;
+  size_t get_size() const override;
+  bool is_empty() const override;
+  void clear() override;
+
+ private:
+  static constexpr size_t MIN_BUCKETS = 2;
+  static constexpr size_t WIDTH_SAMPLE_SIZE = 25;
+  // Popped events a bucket keeps ahead of head before it drops them
+  static constexpr size_t MIN_COMPACT = 32;
+
+  // Events in firing order from head on. Events later than all others in
+  // the bucket, equal times among them, are appended in O(1), and popping
+  // only moves head.
+  struct Bucket {
+    std::vector<Event> events;
+    size_t head = 0;
+
+    bool empty() const { return head == events.size(); }
+    const Event& front() const { return events[head]; }
+    void clear() {
+      events.clear();
+      head = 0;
+    }
+  };
+
+  uint64_t day_of(double time) const;
+  void insert(const Event& event);
+  // Drops the first count events of the bucket
+  void pop_front(Bucket& bucket, size_t count);
+  size_t locate_next() const;  // bucket holding the earliest event
+  void resize(size_t bucket_count, std::span<const Event> extra = {});
+  double estimate_width(std::vector<Event>& events) const;
+
+  std::vector<Bucket> buckets_;
+  size_t bucket_mask_;
+  double width_;
+  size_t size_;
+  // No pending event belongs to a day before current_day_
+  mutable uint64_t current_day_;
+};
+
+#endif  // SIM_EVENT_CALENDAR_QUEUE_H_
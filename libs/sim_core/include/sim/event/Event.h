@@ -2,33 +2,57 @@
 #define SIM_EVENT_EVENT_H_
 
 #include <cstddef>
-#include <memory>
+#include <cstdint>
+#include <type_traits>
 
-class Request;
-class Device;
-
-enum class EventType { arrival, service_end };
+enum class EventType : uint8_t { arrival, service_end };
 
+// Calendar record: the event time, the event type packed together with the
+// index of the source (arrival) or device (service end) it refers to, and
+// the sequence number stamped by EventCalendar::schedule. Trivially copyable
+// so calendar backends move it around with plain memcpy.
 class Event {
  public:
-  Event(double time, EventType type, std::weak_ptr<Request> request,
-        Device* device = nullptr, size_t source_id = 0);
-  double get_time() const;
-  EventType get_type() const;
-  std::weak_ptr<Request> get_request() const;
-  Device* get_device() const;
-  size_t get_request_id() const;
-  size_t get_device_id() const;
-  size_t get_source_id() const;
+  static constexpr size_t MAX_ENTITY_ID = (size_t{1} << 28) - 1;
+
+  Event() = default;
+  Event(double time, EventType type, size_t entity_id);
+
+  double get_time() const { return time_; }
+  void set_time(double time) { time_ = time; }
+  EventType get_type() const {
+    return static_cast<EventType>(key_ >> TYPE_SHIFT);
+  }
+  size_t get_source_id() const { return key_ & ENTITY_MASK; }
+  size_t get_device_id() const { return key_ & ENTITY_MASK; }
+  uint32_t get_sequence() const { return sequence_; }
+  void set_sequence(uint32_t sequence) { sequence_ = sequence; }
 
  private:
+  static constexpr uint32_t TYPE_SHIFT = 28;
+  static constexpr uint32_t ENTITY_MASK = (uint32_t{1} << TYPE_SHIFT) - 1;
+
   double time_;
-  EventType type_;
-  std::weak_ptr<Request> request_;
-  Device* device_;  // Non-owning pointer
-  size_t source_id_;
+  uint32_t key_;       // type << TYPE_SHIFT | entity id
+  uint32_t sequence_;
 };
 
-bool operator<(const Event& lhs, const Event& rhs);
+static_assert(sizeof(Event) == 16, "Event must stay a 16-byte record");
+static_assert(std::is_trivially_copyable_v<Event>,
+              "Event must stay trivially copyable");
+
+// Whether sequence number lhs was stamped before rhs. Compared as serial
+// numbers, so the order survives the 32-bit counter wrapping around; it
+// holds for any two events stamped less than 2^31 schedule() calls apart.
+inline bool is_scheduled_before(uint32_t lhs, uint32_t rhs) {
+  return static_cast<int32_t>(lhs - rhs) < 0;
+}
+
+// Priority order as expected by std::priority_queue: lhs < rhs when lhs fires
+// later. Equal times fire in the order they were scheduled (FIFO).
+inline bool operator<(const Event& lhs, const Event& rhs) {
+  if (lhs.get_time() != rhs.get_time()) return lhs.get_time() > rhs.get_time();
+  return is_scheduled_before(rhs.get_sequence(), lhs.get_sequence());
+}
 
 #endif  // SIM_EVENT_EVENT_H_
\ No newline at end of file
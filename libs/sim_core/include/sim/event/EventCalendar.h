@@ -2,23 +2,134 @@
 #define SIM_EVENT_EVENT_CALENDAR_H_
 
 #include <cstddef>
-#include <queue>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <vector>
 
 #include "sim/event/Event.h"
+#include "sim/event/IEventCalendar.h"
+
+// Identifies a scheduled event. Once that event is popped or cancelled, or
+// the calendar cleared, the handle is stale and cancelling it does nothing.
+class EventHandle {
+ public:
+  EventHandle() = default;
+  const Event& get_event() const { return event_; }
+
+ private:
+  friend class EventCalendar;
+  EventHandle(const Event& event, uint32_t generation)
+      : event_(event), generation_(generation) {}
+
+  Event event_{};
+  uint32_t generation_ = 0;  // of the calendar, never 0 for a scheduled one
+};
 
 class EventCalendar {
  public:
   static constexpr double NO_EVENT_TIME = -1.0;
 
-  EventCalendar();
-  void schedule(const Event& event);
-  Event pop_next();
-  double get_next_time() const;
-  size_t get_size() const;
-  bool is_empty() const;
+  EventCalendar();  // binary heap backend
+  explicit EventCalendar(std::unique_ptr<IEventCalendar> backend);
+
+  // The templated members take an optional Backend naming the concrete
+  // (final) type of the backend held, which turns the calls into it into
+  // direct calls.
+
+  // Stamps the event with the next sequence number before storing it.
+  // Events must not be earlier than the last one popped; throws
+  // std::invalid_argument otherwise.
+  template <class Backend = IEventCalendar>
+  EventHandle schedule(const Event& event) {
+    if (event.get_time() < last_popped_.get_time()) {
+      throw_past_event(event);
+    }
+    Event stamped = event;
+    stamped.set_sequence(next_sequence_++);
+    backend<Backend>().schedule(stamped);
+    return EventHandle(stamped, generation_);
+  }
+  // Stamps the events in place (in span order) and inserts them as one
+  // block, which backends can do in O(n)
+  void schedule_bulk(std::span<Event> events);
+  // Backends that can drop an event in place do so; the others mark it and
+  // skip it lazily once it reaches the front, so a cancel costs O(1). Stale
+  // handles are ignored: events are popped in order and never scheduled
+  // before the last one popped, so one firing no later than that is gone,
+  // and cancelled ones are remembered until then.
+  void cancel(const EventHandle& handle);
+  // Cancels the event if still pending and schedules it at new_time
+  EventHandle reschedule(const EventHandle& handle, double new_time);
+  template <class Backend = IEventCalendar>
+  Event pop_next() {
+    Event event = backend<Backend>().pop_next();
+    last_popped_ = event;
+    if (!cancelled_.empty()) {
+      discard_cancelled_front();
+    }
+    return event;
+  }
+  // Appends every event at the next time to batch, in order, in one call
+  // into the backend. Precondition: !is_empty()
+  template <class Backend = IEventCalendar>
+  void pop_batch(std::vector<Event>& batch) {
+    size_t first = batch.size();
+    backend<Backend>().pop_batch(batch);
+    last_popped_ = batch.back();
+    if (!cancelled_.empty()) {
+      drop_cancelled(batch, first);
+    }
+  }
+  template <class Backend = IEventCalendar>
+  double get_next_time() const {
+    if (is_empty<Backend>()) {
+      return NO_EVENT_TIME;
+    }
+    return backend<Backend>().peek_next().get_time();
+  }
+  template <class Backend = IEventCalendar>
+  size_t get_size() const {
+    return backend<Backend>().get_size() -
+           (cancelled_.size() - discarded_.size());
+  }
+  template <class Backend = IEventCalendar>
+  bool is_empty() const {
+    return get_size<Backend>() == 0;
+  }
+  // Both drop every pending event and restart the sequence numbering;
+  // clear() keeps the backend and its storage
+  void clear();
+  void set_backend(std::unique_ptr<IEventCalendar> backend);
+  const IEventCalendar& get_backend() const;
 
  private:
-  std::priority_queue<Event> events_;
+  template <class Backend>
+  Backend& backend() {
+    return static_cast<Backend&>(*backend_);
+  }
+  template <class Backend>
+  const Backend& backend() const {
+    return static_cast<const Backend&>(*backend_);
+  }
+  void discard_cancelled_front();
+  // Removes the cancelled events from batch, from first on
+  void drop_cancelled(std::vector<Event>& batch, size_t first);
+  void reset();
+  [[noreturn]] static void throw_past_event(const Event& event);
+
+  std::unique_ptr<IEventCalendar> backend_;
+  uint32_t next_sequence_;
+  // Bumped by clear() and set_backend(), which make every handle stale
+  uint32_t generation_;
+  Event last_popped_;
+  // Sequence numbers of cancelled events firing after last_popped_, some
+  // still stored in backend_, the others discarded from it. The front of
+  // backend_ is never one of them.
+  std::unordered_set<uint32_t> cancelled_;
+  // The discarded ones, a heap with the earliest on top
+  std::vector<Event> discarded_;
 };
 
 #endif  // SIM_EVENT_EVENT_CALENDAR_H_
@@ -1,54 +1,418 @@
 #ifndef SIM_EVENT_EVENT_DISPATCHER_H_
 #define SIM_EVENT_EVENT_DISPATCHER_H_
 
+#include <array>
 #include <cstddef>
 #include <memory>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "sim/queue/Buffer.h"
+#include "sim/device/Device.h"
 #include "sim/device/DevicePool.h"
+#include "sim/event/Event.h"
 #include "sim/event/EventCalendar.h"
 #include "sim/metrics/Metrics.h"
-#include "sim/model/Request.h"
+#include "sim/model/RequestPool.h"
 #include "sim/simulator/SimulationConfig.h"
 #include "sim/event/SimulationEvents.h"
+#include "sim/source/Source.h"
 #include "sim/source/SourcePool.h"
 #include "sim/observers/ISimulationObserver.h"
+#include "sim/observers/MetricsObserver.h"
 
-class Device;
-
-class EventDispatcher {
+// Calendar, BufferPolicy, Strategy, ArrivalDist and ServiceDist name the
+// types of the calendar backend, buffer policy, selection strategy and
+// source/device distributions held by the components; with final concrete
+// types every call into them is direct and can be inlined. The interface
+// types accept any configuration. Observers are notified in the order
+// MetricsObserver, Observers..., then those subscribed at run time, each
+// of the event kinds it subscribes to only. Observers... are called as
+// each event happens; those subscribed at run time are sent the events of
+// a batch together when handle_batch_end() ends it, in one virtual call.
+//
+// A Headless dispatcher records into Metrics itself, where MetricsObserver
+// would, with the same arithmetic, so its results are bit-identical. It
+// builds no events for it and has no run-time subscribers: only
+// Observers... are notified.
+template <class Calendar, class BufferPolicy, class Strategy,
+          class ArrivalDist, class ServiceDist, bool Headless = false,
+          class... Observers>
+class BasicEventDispatcher {
  public:
-  EventDispatcher(SourcePool& source_pool, DevicePool& device_pool,
-                  Buffer& buffer, EventCalendar& calendar,
-                  Metrics& metrics, const SimulationConfig& config,
-                  std::vector<std::unique_ptr<ISimulationObserver>>& observers);
+  using StaticObservers =
+      std::conditional_t<Headless, std::tuple<Observers...>,
+                         std::tuple<MetricsObserver, Observers...>>;
+
+  BasicEventDispatcher(
+      SourcePool& source_pool, DevicePool& device_pool, Buffer& buffer,
+      RequestPool& request_pool, EventCalendar& calendar, Metrics& metrics,
+      const SimulationConfig& config, StaticObservers& static_observers)
+      : source_pool_(source_pool),
+        device_pool_(device_pool),
+        buffer_(buffer),
+        request_pool_(request_pool),
+        calendar_(calendar),
+        metrics_(metrics),
+        config_(config),
+        static_observers_(static_observers) {}
+
+  // The observer must outlive its subscription
+  void subscribe(ISimulationObserver& observer) {
+    static_assert(!Headless, "Headless dispatchers take no subscribers");
+    EventMask subscriptions = observer.get_subscriptions();
+    bool batched = false;
+    for (size_t kind = 0; kind < EventMask::KIND_COUNT; ++kind) {
+      if (subscriptions.contains(static_cast<EventKind>(kind))) {
+        subscribers_[kind].push_back(&observer);
+        batched = batched || kind != static_cast<size_t>(EventKind::Batch);
+      }
+    }
+    if (batched) {
+      batch_subscribers_.push_back({&observer, subscriptions});
+      batch_subscriptions_ = batch_subscriptions_ | subscriptions;
+    }
+  }
+
+  void clear_subscribers() {
+    for (auto& subscribers : subscribers_) {
+      subscribers.clear();
+    }
+    batch_subscribers_.clear();
+    batch_subscriptions_ = EventMask();
+  }
+
+  void schedule_initial_arrivals(double start_time) {
+    batch_events_.clear();
+    scheduled_.clear();
+    scheduled_.reserve(source_pool_.size());
+    for (auto& source : source_pool_.get_all_sources()) {
+      double next_time =
+          source->schedule_next_arrival<ArrivalDist>(start_time);
+      if (next_time != Source::NO_EVENT_TIME) {
+        scheduled_.emplace_back(next_time, EventType::arrival,
+                                source->get_id());
+      }
+    }
+    insert_scheduled();
+  }
+
+  // The handlers hold back the events they schedule; this inserts them
+  // into the calendar as one block, in the order they were scheduled
+  void insert_scheduled() {
+    if (!scheduled_.empty()) {
+      calendar_.schedule_bulk(scheduled_);
+      scheduled_.clear();
+    }
+  }
+
+  void handle_arrival(size_t source_id, double current_time) {
+    Source& source = source_pool_.get_source(source_id);
+    if (metrics_.get_arrived() >= config_.max_arrivals) {
+      source.clear_next_arrival_time();
+      return;
+    }
+
+    RequestHandle request = request_pool_.acquire(source_id, current_time);
+
+    if constexpr (Headless) {
+      metrics_.record_arrival(source_id);
+    }
+    notify<ArrivalEvent>([&] {
+      return ArrivalEvent{request_pool_.get(request).get_id(), source_id,
+                          current_time};
+    });
+
+    Device* free_device = device_pool_.find_free_device<Strategy>();
+    if (free_device != nullptr) {
+      start_device_service(free_device, request, current_time);
+    } else {
+      handle_buffer_placement(request, source_id, current_time);
+    }
+
+    if (metrics_.get_arrived() < config_.max_arrivals) {
+      double next_time =
+          source.schedule_next_arrival<ArrivalDist>(current_time);
+      if (next_time != Source::NO_EVENT_TIME) {
+        scheduled_.emplace_back(next_time, EventType::arrival, source_id);
+      }
+    } else {
+      source.clear_next_arrival_time();
+    }
+  }
+
+  void handle_service_end(Device* device, double current_time) {
+    if (!device) {
+      return;
+    }
+
+    RequestHandle finished_handle =
+        device_pool_.finish_service<Strategy>(*device);
+
+    if (finished_handle != NO_REQUEST) {
+      if constexpr (Headless) {
+        const Request& finished_request = request_pool_.get(finished_handle);
+        double service_time =
+            current_time - finished_request.get_service_start_time();
+        metrics_.record_completion(
+            finished_request.get_id(), finished_request.get_source_id(),
+            current_time - finished_request.get_arrival_time(),
+            finished_request.get_service_start_time() -
+                finished_request.get_arrival_time(),
+            service_time);
+        metrics_.record_device_busy_time(device->get_id(), service_time);
+      }
+      notify<ServiceEndEvent>([&] {
+        const Request& finished_request = request_pool_.get(finished_handle);
+        double time_in_system =
+            current_time - finished_request.get_arrival_time();
+        double waiting_time = finished_request.get_service_start_time() -
+                              finished_request.get_arrival_time();
+        double service_time =
+            current_time - finished_request.get_service_start_time();
+
+        return ServiceEndEvent{finished_request.get_id(),
+                               finished_request.get_source_id(),
+                               device->get_id(),
+                               current_time,
+                               time_in_system,
+                               waiting_time,
+                               service_time};
+      });
+      request_pool_.release(finished_handle);
+    }
+
+    device->clear_next_service_end_time();
+    if (!buffer_.is_empty()) {
+      auto [next_request, buffer_slot_index] =
+          buffer_.take_request<BufferPolicy>();
+      if (next_request != NO_REQUEST) {
+        notify<BufferTakeEvent>([&] {
+          const Request& request = request_pool_.get(next_request);
+          return BufferTakeEvent{request.get_id(), request.get_source_id(),
+                                 device->get_id(), buffer_slot_index,
+                                 current_time};
+        });
+
+        start_device_service(device, next_request, current_time);
+      }
+    }
+  }
 
-  void handle_arrival(size_t source_id, double current_time);
-  void handle_service_end(Device* device, double current_time);
+  void handle_batch_end(size_t event_count, double current_time) {
+    if constexpr (!Headless) {
+      if (!batch_events_.empty()) {
+        deliver_batch();
+      }
+    }
+    notify<BatchEvent>([&] { return BatchEvent{current_time, event_count}; });
+  }
 
  private:
+  template <class Observer>
+  static constexpr bool subscribes(EventKind kind) {
+    if constexpr (requires { Observer::SUBSCRIPTIONS; }) {
+      return Observer::SUBSCRIPTIONS.contains(kind);
+    } else {
+      return true;
+    }
+  }
+
+  // Builds the event with build() and sends it to its subscribers, static
+  // observers first; run-time ones get it with the rest of the batch. With
+  // none, build() is never called.
+  template <class Event, class Build>
+  void notify(const Build& build) {
+    constexpr EventKind kind = Event::KIND;
+    constexpr bool static_subscribers =
+        ((!Headless && subscribes<MetricsObserver>(kind)) || ... ||
+         subscribes<Observers>(kind));
+    const auto& subscribers = subscribers_[static_cast<size_t>(kind)];
+    if (!static_subscribers && (Headless || subscribers.empty())) {
+      return;
+    }
+
+    const Event event = build();
+    std::apply(
+        [&](auto&... observer) { (deliver_static(observer, event), ...); },
+        static_observers_);
+    if constexpr (!Headless) {
+      if constexpr (kind == EventKind::Batch) {
+        for (ISimulationObserver* observer : subscribers) {
+          deliver(*observer, event);
+        }
+      } else if (!subscribers.empty()) {
+        batch_events_.emplace_back(event);
+      }
+    }
+  }
+
+  // Observers subscribed to fewer kinds than the others together get the
+  // batch filtered
+  void deliver_batch() {
+    for (const auto& [observer, subscriptions] : batch_subscribers_) {
+      if ((subscriptions | EventMask{EventKind::Batch})
+              .contains(batch_subscriptions_)) {
+        observer->on_events(batch_events_);
+        continue;
+      }
+      filtered_events_.clear();
+      for (const auto& event : batch_events_) {
+        if (subscriptions.contains(static_cast<EventKind>(event.index()))) {
+          filtered_events_.push_back(event);
+        }
+      }
+      if (!filtered_events_.empty()) {
+        observer->on_events(filtered_events_);
+      }
+    }
+    batch_events_.clear();
+  }
+
+  template <class Observer, class Event>
+  static void deliver_static(Observer& observer, const Event& event) {
+    if constexpr (subscribes<Observer>(Event::KIND)) {
+      deliver(observer, event);
+    }
+  }
+
+  template <class Observer>
+  static void deliver(Observer& observer, const ArrivalEvent& event) {
+    observer.on_arrival(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const ServiceStartEvent& event) {
+    observer.on_service_start(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const ServiceEndEvent& event) {
+    observer.on_service_end(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const BufferPlaceEvent& event) {
+    observer.on_buffer_place(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const BufferTakeEvent& event) {
+    observer.on_buffer_take(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const BufferDisplacedEvent& event) {
+    observer.on_buffer_displaced(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const RefusalEvent& event) {
+    observer.on_refusal(event);
+  }
+  template <class Observer>
+  static void deliver(Observer& observer, const BatchEvent& event) {
+    observer.on_batch(event);
+  }
+
+  void start_device_service(Device* device, RequestHandle request,
+                            double current_time) {
+    if (!device || request == NO_REQUEST) {
+      return;
+    }
+
+    Request& started_request = request_pool_.get(request);
+    started_request.set_service_start_time(current_time);
+    device_pool_.start_service<Strategy>(*device, request);
+
+    double service_end_time =
+        device->schedule_next_service_end<ServiceDist>(current_time);
+    scheduled_.emplace_back(service_end_time, EventType::service_end,
+                            device->get_id());
+
+    notify<ServiceStartEvent>([&] {
+      return ServiceStartEvent{started_request.get_id(),
+                               started_request.get_source_id(),
+                               device->get_id(), current_time};
+    });
+  }
+
+  void handle_buffer_placement(RequestHandle request, size_t source_id,
+                               double current_time) {
+    if (request == NO_REQUEST) {
+      return;
+    }
+
+    auto buffer_slot =
+        buffer_.place_request<BufferPolicy>(request, source_id);
+    if (buffer_slot.has_value()) {
+      notify<BufferPlaceEvent>([&] {
+        return BufferPlaceEvent{request_pool_.get(request).get_id(), source_id,
+                                *buffer_slot, current_time};
+      });
+      return;
+    }
+
+    // Buffer full: the discipline picks the request to displace, or
+    // refuses the arrival
+    RequestHandle displaced_handle =
+        buffer_.displace_request<BufferPolicy>(source_id);
+    if (displaced_handle == NO_REQUEST) {
+      if constexpr (Headless) {
+        metrics_.record_refusal(source_id);
+      }
+      notify<RefusalEvent>([&] {
+        return RefusalEvent{request_pool_.get(request).get_id(), source_id,
+                            current_time};
+      });
+      request_pool_.release(request);
+      return;
+    }
+
+    if constexpr (Headless) {
+      metrics_.record_refusal(
+          request_pool_.get(displaced_handle).get_source_id());
+    }
+    notify<BufferDisplacedEvent>([&] {
+      const Request& displaced_request = request_pool_.get(displaced_handle);
+      return BufferDisplacedEvent{displaced_request.get_id(),
+                                  displaced_request.get_source_id(),
+                                  current_time};
+    });
+    request_pool_.release(displaced_handle);
+
+    // Place the new request in the freed slot
+    size_t new_slot =
+        *buffer_.place_request<BufferPolicy>(request, source_id);
+    notify<BufferPlaceEvent>([&] {
+      return BufferPlaceEvent{request_pool_.get(request).get_id(), source_id,
+                              new_slot, current_time};
+    });
+  }
+
   SourcePool& source_pool_;
   DevicePool& device_pool_;
   Buffer& buffer_;
+  RequestPool& request_pool_;
   EventCalendar& calendar_;
   Metrics& metrics_;
   const SimulationConfig& config_;
-  std::vector<std::unique_ptr<ISimulationObserver>>& observers_;
-
-  // Helper methods
-  void notify_arrival(const ArrivalEvent& event);
-  void notify_service_start(const ServiceStartEvent& event);
-  void notify_service_end(const ServiceEndEvent& event);
-  void notify_buffer_place(const BufferPlaceEvent& event);
-  void notify_buffer_take(const BufferTakeEvent& event);
-  void notify_buffer_displaced(const BufferDisplacedEvent& event);
-  void notify_refusal(const RefusalEvent& event);
-
-  void start_device_service(Device* device, std::shared_ptr<Request> request,
-                            double current_time);
-  void handle_buffer_placement(std::shared_ptr<Request> request,
-                               size_t source_id, double current_time);
+  StaticObservers& static_observers_;
+  // Per event kind, the observers subscribed to it at run time
+  std::array<std::vector<ISimulationObserver*>, EventMask::KIND_COUNT>
+      subscribers_;
+  // Those subscribed to any kind but Batch, and the union of their kinds
+  struct BatchSubscriber {
+    ISimulationObserver* observer;
+    EventMask subscriptions;
+  };
+  std::vector<BatchSubscriber> batch_subscribers_;
+  EventMask batch_subscriptions_;
+  // Events of the current batch for them
+  std::vector<SimulationEvent> batch_events_;
+  std::vector<SimulationEvent> filtered_events_;
+  std::vector<Event> scheduled_;
 };
 
+// Dispatcher going through the component interfaces
+using EventDispatcher =
+    BasicEventDispatcher<IEventCalendar, IBufferPolicy,
+                         IDeviceSelectionStrategy, IDistribution,
+                         IDistribution>;
+
 #endif  // SIM_EVENT_EVENT_DISPATCHER_H_
@@ -0,0 +1,136 @@
+#ifndef SIM_EVENT_EVENT_TRACE_H_
+#define SIM_EVENT_EVENT_TRACE_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "sim/event/SimulationEvents.h"
+
+// One event as read back from a trace. ServiceEnd durations are not kept:
+// they follow from the request's Arrival and ServiceStart records.
+struct TraceRecord {
+  EventKind kind;
+  double time;
+  size_t request_id;
+  size_t source_id;
+  size_t device_id;    // ServiceStart, ServiceEnd and BufferTake only
+  size_t buffer_slot;  // BufferPlace and BufferTake only
+};
+
+// Layout of the event trace files EventTraceObserver writes and
+// EventTraceReader reads, headers in host byte order:
+//
+//   "SIMEVTR1"
+//   chunks, each a ChunkHeader and its records
+//   the index, one IndexEntry per chunk, then the Trailer
+//
+// A record holds the time's bit pattern minus the previous record's, the
+// request id minus the previous one zigzagged, the source id, and the
+// device id and buffer slot where the kind has them. Each field takes as
+// few little-endian bytes as its value needs, none for 0, so writing or
+// reading one is an unaligned 8-byte access without branches. The lengths
+// go in tag bytes: the kind in bits 0-2 and the time's length in bits 3-6
+// ahead of the time, and the lengths of the request and source, and of
+// the device and slot, in the nibbles of a byte ahead of the pair.
+//
+// The first record of a chunk is relative to the chunk header, so chunks
+// decode on their own. Times within a chunk never decrease.
+//
+// The index and trailer are written last; a trace cut short without them
+// is read up to its last complete chunk.
+class EventTrace {
+ public:
+  static constexpr char MAGIC[8] = {'S', 'I', 'M', 'E', 'V', 'T', 'R', '1'};
+  static constexpr char INDEX_MAGIC[8] = {'S', 'I', 'M', 'E',
+                                          'V', 'I', 'X', '1'};
+
+  // Records per chunk, which bounds the decoding a seek needs
+  static constexpr size_t CHUNK_RECORDS = 1024;
+  static constexpr size_t MAX_RECORD_BYTES = 3 + 5 * sizeof(uint64_t);
+
+  struct ChunkHeader {
+    uint32_t record_count;
+    uint32_t payload_bytes;
+    double first_time;
+    uint64_t first_request_id;
+    uint64_t first_record;
+  };
+
+  struct IndexEntry {
+    double first_time;
+    uint64_t offset;
+    uint64_t first_record;
+  };
+
+  struct Trailer {
+    uint64_t index_offset;
+    uint64_t chunk_count;
+    uint64_t record_count;
+    char magic[8];
+  };
+
+  // put_field() stores whole words past the end of the record
+  static constexpr size_t MAX_CHUNK_BYTES =
+      sizeof(ChunkHeader) + CHUNK_RECORDS * MAX_RECORD_BYTES +
+      sizeof(uint64_t);
+
+  static bool has_device(EventKind kind) {
+    return kind == EventKind::ServiceStart || kind == EventKind::ServiceEnd ||
+           kind == EventKind::BufferTake;
+  }
+  static bool has_buffer_slot(EventKind kind) {
+    return kind == EventKind::BufferPlace || kind == EventKind::BufferTake;
+  }
+
+  // Bytes a field takes, 0 to 8
+  static unsigned get_length(uint64_t value) {
+    return static_cast<unsigned>(71 - std::countl_zero(value)) / 8;
+  }
+
+  // Stores all 8 bytes of value and returns the end of the first length
+  static std::byte* put_field(std::byte* out, uint64_t value,
+                              unsigned length) {
+    value = little_endian(value);
+    std::memcpy(out, &value, sizeof(value));
+    return out + length;
+  }
+
+  // Reads a field of length bytes, of which there must be 8 at in
+  static uint64_t get_field(const std::byte* in, unsigned length) {
+    uint64_t value;
+    std::memcpy(&value, in, sizeof(value));
+    value = little_endian(value);
+    return length == 0 ? 0 : value & (~uint64_t{0} >> (64 - 8 * length));
+  }
+
+  // A tag byte with both lengths, then both fields
+  static std::byte* put_pair(std::byte* out, uint64_t low, uint64_t high) {
+    unsigned low_length = get_length(low);
+    unsigned high_length = get_length(high);
+    *out = static_cast<std::byte>(low_length | high_length << 4);
+    return put_field(put_field(out + 1, low, low_length), high, high_length);
+  }
+
+  // Swaps the bytes on big-endian hosts, in both directions
+  static uint64_t little_endian(uint64_t value) {
+    if constexpr (std::endian::native == std::endian::big) {
+      uint64_t swapped = 0;
+      for (int i = 0; i < 8; ++i, value >>= 8) {
+        swapped = swapped << 8 | (value & 0xff);
+      }
+      return swapped;
+    }
+    return value;
+  }
+
+  static uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+  }
+  static uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+  }
+};
+
+#endif  // SIM_EVENT_EVENT_TRACE_H_
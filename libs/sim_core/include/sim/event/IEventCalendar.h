@@ -0,0 +1,43 @@
+#ifndef SIM_EVENT_I_EVENT_CALENDAR_H_
+#define SIM_EVENT_I_EVENT_CALENDAR_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "sim/event/Event.h"
+
+// Storage backend of the EventCalendar. Implementations must hand events back
+// in the order defined by operator<(Event, Event), earliest first.
+class IEventCalendar {
+ public:
+  virtual ~IEventCalendar() = default;
+
+  virtual void schedule(const Event& event) = 0;
+  virtual void schedule_bulk(std::span<const Event> events) {
+    for (const auto& event : events) {
+      schedule(event);
+    }
+  }
+  virtual Event pop_next() = 0;
+  // Appends every event at the earliest pending time to batch, in order.
+  // Precondition: !is_empty()
+  virtual void pop_batch(std::vector<Event>& batch) {
+    double time = peek_next().get_time();
+    do {
+      batch.push_back(pop_next());
+    } while (!is_empty() && peek_next().get_time() == time);
+  }
+  // Precondition: !is_empty()
+  virtual Event peek_next() const = 0;
+  virtual size_t get_size() const = 0;
+  virtual bool is_empty() const = 0;
+  // Drops every pending event but keeps allocated storage for reuse
+  virtual void clear() = 0;
+
+  // Removes a pending event in place if the backend can locate it cheaply.
+  // Returns false when unsupported; EventCalendar then deletes lazily.
+  virtual bool remove(const Event& /*event*/) { return false; }
+};
+
+#endif  // SIM_EVENT_I_EVENT_CALENDAR_H_
@@ -0,0 +1,70 @@
+#ifndef SIM_EVENT_LADDER_QUEUE_H_
+#define SIM_EVENT_LADDER_QUEUE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "sim/event/IEventCalendar.h"
+
+// Ladder queue (Tang, Goh & Thng): far-future events sit unsorted in Top,
+// are spread over a ladder of bucket rungs on demand, and only the bucket
+// about to be dequeued is sorted into Bottom. Dense buckets are split into a
+// finer child rung instead of being sorted, so skewed or bursty event-time
+// distributions keep O(1) amortized cost.
+class LadderQueue final : public IEventCalendar {
+ public:
+  LadderQueue();
+
+  void schedule(const Event& event) override;
+  void schedule_bulk(std::span<const Event> events) override;
+  Event pop_next() override;
+  void pop_batch(std::vector<Event>& batch) override;
+  Event peek_next() const override;
+  size_t get_size() const override;
+  bool is_empty() const override;
+  void clear() override;
+
+ private:
+  // Buckets holding more events than this are split into a child rung
+  static constexpr size_t BUCKET_THRESHOLD = 50;
+  static constexpr size_t MAX_RUNGS = 8;
+  // Popped events Bottom keeps ahead of its head before it drops them
+  static constexpr size_t MIN_COMPACT = 32;
+
+  struct Rung {
+    double start = 0.0;
+    double width = 0.0;
+    size_t current = 0;  // first bucket not yet handed down
+    size_t size = 0;
+    std::vector<std::vector<Event>> buckets;
+  };
+
+  size_t bucket_index(const Rung& rung, double time) const;
+  void insert(const Event& event);
+  void insert_into_bottom(const Event& event);
+  void refill_bottom();
+  void spawn_rung(double start, double end);
+  void sort_into_bottom();
+
+  // Top: unsorted events at or after top_start_
+  std::vector<Event> top_;
+  double top_start_;
+  double top_min_;
+  double top_max_;
+
+  // rungs_[0 .. active_rungs_) are in use; the rest keep their capacity
+  std::vector<Rung> rungs_;
+  size_t active_rungs_;
+
+  // Bottom: the events from bottom_head_ on, in firing order, so later
+  // events and equal times are appended in O(1). Whenever the queue is not
+  // empty, Bottom is not empty either.
+  bool is_bottom_empty() const { return bottom_head_ == bottom_.size(); }
+  std::vector<Event> bottom_;
+  size_t bottom_head_;
+
+  std::vector<Event> scratch_;
+  size_t size_;
+};
+
+#endif  // SIM_EVENT_LADDER_QUEUE_H_
@@ -2,14 +2,32 @@
 #define SIM_EVENT_SIMULATION_EVENTS_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <variant>
+
+// One per event struct below, which names its kind as KIND
+enum class EventKind : uint8_t {
+  Arrival,
+  ServiceStart,
+  ServiceEnd,
+  BufferPlace,
+  BufferTake,
+  BufferDisplaced,
+  Refusal,
+  Batch
+};
 
 struct ArrivalEvent {
+  static constexpr EventKind KIND = EventKind::Arrival;
+
   size_t request_id;
   size_t source_id;
   double time;
 };
 
 struct ServiceStartEvent {
+  static constexpr EventKind KIND = EventKind::ServiceStart;
+
   size_t request_id;
   size_t source_id;
   size_t device_id;
@@ -17,6 +35,8 @@ struct ServiceStartEvent {
 };
 
 struct ServiceEndEvent {
+  static constexpr EventKind KIND = EventKind::ServiceEnd;
+
   size_t request_id;
   size_t source_id;
   size_t device_id;
@@ -27,6 +47,8 @@ struct ServiceEndEvent {
 };
 
 struct BufferPlaceEvent {
+  static constexpr EventKind KIND = EventKind::BufferPlace;
+
   size_t request_id;
   size_t source_id;
   size_t buffer_slot;
@@ -34,6 +56,8 @@ struct BufferPlaceEvent {
 };
 
 struct BufferTakeEvent {
+  static constexpr EventKind KIND = EventKind::BufferTake;
+
   size_t request_id;
   size_t source_id;
   size_t device_id;
@@ -42,15 +66,33 @@ struct BufferTakeEvent {
 };
 
 struct BufferDisplacedEvent {
+  static constexpr EventKind KIND = EventKind::BufferDisplaced;
+
   size_t request_id;
   size_t source_id;
   double time;
 };
 
 struct RefusalEvent {
+  static constexpr EventKind KIND = EventKind::Refusal;
+
   size_t request_id;
   size_t source_id;
   double time;
 };
 
+// Any of the events above, its index being its kind
+using SimulationEvent =
+    std::variant<ArrivalEvent, ServiceStartEvent, ServiceEndEvent,
+                 BufferPlaceEvent, BufferTakeEvent, BufferDisplacedEvent,
+                 RefusalEvent>;
+
+// Sent once after all calendar events sharing a timestamp were dispatched
+struct BatchEvent {
+  static constexpr EventKind KIND = EventKind::Batch;
+
+  double time;
+  size_t event_count;
+};
+
 #endif  // SIM_EVENT_SIMULATION_EVENTS_H_
@@ -0,0 +1,53 @@
+#ifndef SIM_EVENT_TOURNAMENT_CALENDAR_H_
+#define SIM_EVENT_TOURNAMENT_CALENDAR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/event/IEventCalendar.h"
+
+// Fixed-slot calendar for models where every Source has at most one pending
+// arrival and every Device at most one pending service end. Slot i holds the
+// next arrival of source i, slot num_sources + j the service end of device j;
+// a winner tree over the slots yields the earliest one. Scheduling into an
+// occupied slot throws std::logic_error; a reschedule is a remove() and a
+// schedule(), each an O(log n) in-place update with no allocation. Events
+// are rebuilt from the slot index, so only the time and sequence number of
+// each slot are stored.
+class TournamentCalendar final : public IEventCalendar {
+ public:
+  TournamentCalendar(size_t num_sources, size_t num_devices);
+
+  void schedule(const Event& event) override;
+  void schedule_bulk(std::span<const Event> events) override;
+  Event pop_next() override;
+  void pop_batch(std::vector<Event>& batch) override;
+  Event peek_next() const override;
+  size_t get_size() const override;
+  bool is_empty() const override;
+  void clear() override;
+  bool remove(const Event& event) override;
+
+ private:
+  size_t slot_of(const Event& event) const;
+  // Stores the event in its slot, which must be empty
+  size_t occupy(const Event& event);
+  void vacate(size_t slot);
+  Event make_event(size_t slot) const;
+  bool wins(size_t lhs, size_t rhs) const;
+  void update(size_t slot);
+  void rebuild();
+
+  size_t num_sources_;
+  size_t slot_count_;
+  size_t leaf_count_;             // power of two >= slot_count_
+  std::vector<double> times_;        // per slot plus a sentinel, +inf if empty
+  std::vector<uint32_t> sequences_;
+  // Tells an event at +inf from an empty slot
+  std::vector<uint8_t> occupied_;
+  std::vector<size_t> tree_;      // tree_[1] is the overall winner slot
+  size_t size_;
+};
+
+#endif  // SIM_EVENT_TOURNAMENT_CALENDAR_H_
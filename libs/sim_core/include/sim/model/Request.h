@@ -5,7 +5,7 @@
 
 class Request {
  public:
-  Request(size_t source_id, double t_arrival);
+  Request(size_t id, size_t source_id, double t_arrival);
   size_t get_id() const;
   size_t get_source_id() const;
   double get_arrival_time() const;
@@ -13,7 +13,6 @@ class Request {
   double get_service_start_time() const;
 
  private:
-  static size_t next_id_;
   size_t id_;
   size_t source_id_;
   double t_arrival_;
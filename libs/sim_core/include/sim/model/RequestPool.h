@@ -0,0 +1,45 @@
+#ifndef SIM_MODEL_REQUEST_POOL_H_
+#define SIM_MODEL_REQUEST_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "sim/model/Request.h"
+
+// Index of a Request inside its RequestPool
+using RequestHandle = uint32_t;
+
+inline constexpr RequestHandle NO_REQUEST =
+    std::numeric_limits<RequestHandle>::max();
+
+// Slab of Request records recycled through a free list. Released slots are
+// reused before the slab grows, so once the pool has reached the peak number
+// of live requests it no longer allocates. Handles stay valid until released;
+// references returned by get() only until the next acquire(). Request ids are
+// numbered per pool, starting at 1, so each simulator owns its sequence.
+class RequestPool {
+ public:
+  explicit RequestPool(size_t initial_capacity = 0);
+
+  RequestHandle acquire(size_t source_id, double t_arrival);
+  void release(RequestHandle handle);
+
+  Request& get(RequestHandle handle);
+  const Request& get(RequestHandle handle) const;
+
+  size_t get_live_count() const;
+  size_t get_capacity() const;
+
+  // Releases every request and restarts the ids at 1, keeping the storage
+  void clear();
+  void reserve(size_t capacity);
+
+ private:
+  std::vector<Request> slab_;
+  std::vector<RequestHandle> free_list_;
+  size_t next_id_;
+};
+
+#endif  // SIM_MODEL_REQUEST_POOL_H_
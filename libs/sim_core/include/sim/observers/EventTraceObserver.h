@@ -0,0 +1,132 @@
+#ifndef SIM_OBSERVERS_EVENT_TRACE_OBSERVER_H_
+#define SIM_OBSERVERS_EVENT_TRACE_OBSERVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "sim/event/EventTrace.h"
+#include "sim/observers/ISimulationObserver.h"
+
+// Writes every event but the batch ends to a compact binary trace (see
+// EventTrace), for EventTraceReader to read back. The simulation thread
+// only copies the events into blocks; a writer thread encodes them and
+// writes them out, a chunk at a time, so memory use does not grow with the
+// run. Without a second core there is no writer thread, and the simulation
+// thread encodes each block itself. A simulator rewound while traced
+// starts a new chunk at time 0.
+//
+// Usable as one of BasicSimulator's Observers...: default-constructed it
+// records nothing until open(), and it records nothing after finish().
+class EventTraceObserver final : public ISimulationObserver {
+ public:
+  static constexpr EventMask SUBSCRIPTIONS{
+      EventKind::Arrival,    EventKind::ServiceStart,
+      EventKind::ServiceEnd, EventKind::BufferPlace,
+      EventKind::BufferTake, EventKind::BufferDisplaced,
+      EventKind::Refusal};
+
+  EventTraceObserver();
+  // Opens path; throws as open()
+  explicit EventTraceObserver(const std::string& path);
+  EventTraceObserver(EventTraceObserver&& other) noexcept;
+  EventTraceObserver& operator=(EventTraceObserver&& other) = delete;
+  // Calls finish(), ignoring errors
+  ~EventTraceObserver() override;
+
+  EventMask get_subscriptions() const override { return SUBSCRIPTIONS; }
+
+  void on_events(std::span<const SimulationEvent> events) override;
+  void on_arrival(const ArrivalEvent& event) override {
+    add(to_record(event));
+  }
+  void on_service_start(const ServiceStartEvent& event) override {
+    add(to_record(event));
+  }
+  void on_service_end(const ServiceEndEvent& event) override {
+    add(to_record(event));
+  }
+  void on_buffer_place(const BufferPlaceEvent& event) override {
+    add(to_record(event));
+  }
+  void on_buffer_take(const BufferTakeEvent& event) override {
+    add(to_record(event));
+  }
+  void on_buffer_displaced(const BufferDisplacedEvent& event) override {
+    add(to_record(event));
+  }
+  void on_refusal(const RefusalEvent& event) override {
+    add(to_record(event));
+  }
+
+  // Finishes the trace being written, if any, and starts one in path.
+  // Throws std::runtime_error if the file cannot be created.
+  void open(const std::string& path);
+  // Writes the last chunk and the index and closes the file. Throws
+  // std::runtime_error on write errors, which may also surface from the
+  // event calls before.
+  void finish();
+
+  bool is_open() const { return writer_ != nullptr; }
+  // Whether the blocks are written on a thread of their own
+  static bool has_writer_thread();
+  // Records of the trace being written or last finished
+  uint64_t get_record_count() const {
+    return record_count_ + (is_open() ? block_size_ : 0);
+  }
+
+ private:
+  // Records handed to the writer at a time
+  static constexpr size_t BLOCK_RECORDS = 4096;
+
+  class Writer;
+
+  // Absent fields are 0
+  static TraceRecord to_record(const ArrivalEvent& event) {
+    return {EventKind::Arrival, event.time, event.request_id,
+            event.source_id, 0, 0};
+  }
+  static TraceRecord to_record(const ServiceStartEvent& event) {
+    return {EventKind::ServiceStart, event.time, event.request_id,
+            event.source_id, event.device_id, 0};
+  }
+  static TraceRecord to_record(const ServiceEndEvent& event) {
+    return {EventKind::ServiceEnd, event.time, event.request_id,
+            event.source_id, event.device_id, 0};
+  }
+  static TraceRecord to_record(const BufferPlaceEvent& event) {
+    return {EventKind::BufferPlace, event.time, event.request_id,
+            event.source_id, 0, event.buffer_slot};
+  }
+  static TraceRecord to_record(const BufferTakeEvent& event) {
+    return {EventKind::BufferTake, event.time, event.request_id,
+            event.source_id, event.device_id, event.buffer_slot};
+  }
+  static TraceRecord to_record(const BufferDisplacedEvent& event) {
+    return {EventKind::BufferDisplaced, event.time, event.request_id,
+            event.source_id, 0, 0};
+  }
+  static TraceRecord to_record(const RefusalEvent& event) {
+    return {EventKind::Refusal, event.time, event.request_id,
+            event.source_id, 0, 0};
+  }
+
+  void add(const TraceRecord& record) {
+    if (block_size_ == BLOCK_RECORDS) {
+      hand_off();
+    }
+    block_[block_size_++] = record;
+  }
+  // Sends the block to the writer and takes an empty one, dropping the
+  // records instead while no trace is open
+  void hand_off();
+
+  std::unique_ptr<Writer> writer_;
+  std::unique_ptr<TraceRecord[]> block_;
+  size_t block_size_;
+  uint64_t record_count_;
+};
+
+#endif  // SIM_OBSERVERS_EVENT_TRACE_OBSERVER_H_
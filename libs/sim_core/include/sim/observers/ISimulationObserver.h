@@ -1,11 +1,63 @@
 #ifndef SIM_OBSERVERS_I_SIMULATION_OBSERVER_H_
 #define SIM_OBSERVERS_I_SIMULATION_OBSERVER_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+
 #include "sim/event/SimulationEvents.h"
 
+// Set of event kinds, one bit each
+class EventMask {
+ public:
+  static constexpr size_t KIND_COUNT = 8;
+
+  constexpr EventMask() = default;
+  constexpr EventMask(std::initializer_list<EventKind> kinds) {
+    for (EventKind kind : kinds) {
+      bits_ |= bit(kind);
+    }
+  }
+
+  static constexpr EventMask all() {
+    EventMask mask;
+    mask.bits_ = (uint32_t{1} << KIND_COUNT) - 1;
+    return mask;
+  }
+
+  constexpr bool contains(EventKind kind) const {
+    return (bits_ & bit(kind)) != 0;
+  }
+  constexpr bool contains(EventMask other) const {
+    return (bits_ & other.bits_) == other.bits_;
+  }
+  constexpr EventMask operator|(EventMask other) const {
+    EventMask mask;
+    mask.bits_ = bits_ | other.bits_;
+    return mask;
+  }
+
+ private:
+  static constexpr uint32_t bit(EventKind kind) {
+    return uint32_t{1} << static_cast<uint32_t>(kind);
+  }
+
+  uint32_t bits_ = 0;
+};
+
+// Observers added at run time are sent the events of each batch together,
+// through on_events(), then on_batch(); those given to BasicSimulator as
+// Observers... are called for each event as it happens.
 class ISimulationObserver {
  public:
   virtual ~ISimulationObserver() = default;
+  // The kinds of event the observer is sent; read once when it is added
+  // to a simulator. Events no observer subscribes to are not even built.
+  virtual EventMask get_subscriptions() const { return EventMask::all(); }
+  // The events of one batch of the kinds subscribed to, in the order they
+  // happened. Passes each to its on_ member below unless overridden.
+  virtual void on_events(std::span<const SimulationEvent> events);
   virtual void on_arrival(const ArrivalEvent&) {}
   virtual void on_service_start(const ServiceStartEvent&) {}
   virtual void on_service_end(const ServiceEndEvent&) {}
@@ -13,6 +65,7 @@ class ISimulationObserver {
   virtual void on_buffer_take(const BufferTakeEvent&) {}
   virtual void on_buffer_displaced(const BufferDisplacedEvent&) {}
   virtual void on_refusal(const RefusalEvent&) {}
+  virtual void on_batch(const BatchEvent&) {}
 };
 
 #endif  // SIM_OBSERVERS_I_SIMULATION_OBSERVER_H_
@@ -5,11 +5,19 @@
 
 class Metrics;
 
-class MetricsObserver : public ISimulationObserver {
+class MetricsObserver final : public ISimulationObserver {
  public:
+  // Static observers may declare SUBSCRIPTIONS, which the dispatcher then
+  // honours at compile time
+  static constexpr EventMask SUBSCRIPTIONS{
+      EventKind::Arrival, EventKind::ServiceEnd, EventKind::BufferDisplaced,
+      EventKind::Refusal};
+
   explicit MetricsObserver(Metrics& metrics);
   ~MetricsObserver() override = default;
 
+  EventMask get_subscriptions() const override { return SUBSCRIPTIONS; }
+
   void on_arrival(const ArrivalEvent& event) override;
   void on_service_end(const ServiceEndEvent& event) override;
   void on_buffer_displaced(const BufferDisplacedEvent& event) override;
@@ -4,29 +4,63 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
-#include <vector>
+#include <utility>
 
-#include "sim/model/Request.h"
+#include "sim/model/RequestPool.h"
+#include "sim/queue/IBufferPolicy.h"
 
 class Buffer {
  public:
-  Buffer(size_t capacity);
+  Buffer(size_t capacity);  // slot-rotating policy
+  Buffer(size_t capacity, std::unique_ptr<IBufferPolicy> policy);
+
+  // Policy may name the concrete (final) type of the policy held, which
+  // turns the calls into the discipline into direct calls
+  template <class Policy = IBufferPolicy>
   std::optional<size_t> place_request(
-      std::shared_ptr<Request> request);  // returns slot index
-  std::shared_ptr<Request> displace_request();
-  std::pair<std::shared_ptr<Request>, size_t>
-  take_request();  // returns (request, slot_index)
+      RequestHandle request, size_t source_id) {  // returns slot index
+    if (is_full() || request == NO_REQUEST) {
+      return std::nullopt;
+    }
+    ++size_;
+    return static_cast<Policy&>(*policy_).place(request, source_id);
+  }
+  template <class Policy = IBufferPolicy>
+  RequestHandle displace_request(size_t source_id) {
+    if (is_empty()) {
+      return NO_REQUEST;
+    }
+    RequestHandle request =
+        static_cast<Policy&>(*policy_).displace(source_id);
+    if (request != NO_REQUEST) {
+      --size_;
+    }
+    return request;
+  }
+  template <class Policy = IBufferPolicy>
+  std::pair<RequestHandle, size_t>
+  take_request() {  // returns (request, slot_index)
+    if (is_empty()) {
+      return {NO_REQUEST, 0};
+    }
+    --size_;
+    return static_cast<Policy&>(*policy_).take();
+  }
+
   bool is_empty() const;
   bool is_full() const;
   size_t get_size() const;
   size_t get_capacity() const;
+  // Empties the buffer and resizes it, reusing the slot storage
+  void reset(size_t capacity);
+  // Empties the buffer and switches to another discipline
+  void set_policy(size_t capacity, std::unique_ptr<IBufferPolicy> policy);
+  const IBufferPolicy& get_policy() const;
 
  private:
-  std::vector<std::shared_ptr<Request>> slots_;
+  std::unique_ptr<IBufferPolicy> policy_;
   size_t capacity_;
   size_t size_;
-  size_t place_start_;
-  size_t select_start_;
 };
 
 #endif  // SIM_QUEUE_BUFFER_H_
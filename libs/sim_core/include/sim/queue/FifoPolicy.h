@@ -0,0 +1,26 @@
+#ifndef SIM_QUEUE_FIFO_POLICY_H_
+#define SIM_QUEUE_FIFO_POLICY_H_
+
+#include <vector>
+
+#include "sim/queue/IBufferPolicy.h"
+
+// Ring buffer served oldest first. A full buffer displaces the newest
+// request, or the oldest one when displace_oldest is set.
+class FifoPolicy final : public IBufferPolicy {
+ public:
+  FifoPolicy(size_t capacity, bool displace_oldest);
+
+  size_t place(RequestHandle request, size_t source_id) override;
+  std::pair<RequestHandle, size_t> take() override;
+  RequestHandle displace(size_t source_id) override;
+  void reset(size_t capacity) override;
+
+ private:
+  std::vector<RequestHandle> ring_;
+  size_t head_;  // slot of the oldest request
+  size_t count_;
+  bool displace_oldest_;
+};
+
+#endif  // SIM_QUEUE_FIFO_POLICY_H_
@@ -0,0 +1,27 @@
+#ifndef SIM_QUEUE_I_BUFFER_POLICY_H_
+#define SIM_QUEUE_I_BUFFER_POLICY_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "sim/model/RequestPool.h"
+
+// Storage and ordering discipline behind Buffer. Buffer tracks the fill
+// level, so place() is only called when there is a free slot and take() and
+// displace() only when at least one request is stored.
+class IBufferPolicy {
+ public:
+  virtual ~IBufferPolicy() = default;
+
+  // Stores the request and returns the slot index it occupies
+  virtual size_t place(RequestHandle request, size_t source_id) = 0;
+  // Removes the next request to serve; returns (request, slot_index)
+  virtual std::pair<RequestHandle, size_t> take() = 0;
+  // Removes the request pushed out by an arrival from source_id at a full
+  // buffer, or returns NO_REQUEST to refuse the arrival instead
+  virtual RequestHandle displace(size_t source_id) = 0;
+  // Empties the policy and resizes it, reusing allocated storage
+  virtual void reset(size_t capacity) = 0;
+};
+
+#endif  // SIM_QUEUE_I_BUFFER_POLICY_H_
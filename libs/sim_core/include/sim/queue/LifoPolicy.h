@@ -0,0 +1,23 @@
+#ifndef SIM_QUEUE_LIFO_POLICY_H_
+#define SIM_QUEUE_LIFO_POLICY_H_
+
+#include <vector>
+
+#include "sim/queue/IBufferPolicy.h"
+
+// Stack served newest first; a full buffer displaces the newest request.
+// The slot index is the stack depth.
+class LifoPolicy final : public IBufferPolicy {
+ public:
+  explicit LifoPolicy(size_t capacity);
+
+  size_t place(RequestHandle request, size_t source_id) override;
+  std::pair<RequestHandle, size_t> take() override;
+  RequestHandle displace(size_t source_id) override;
+  void reset(size_t capacity) override;
+
+ private:
+  std::vector<RequestHandle> stack_;
+};
+
+#endif  // SIM_QUEUE_LIFO_POLICY_H_
@@ -0,0 +1,31 @@
+#ifndef SIM_QUEUE_SLOT_ROTATING_POLICY_H_
+#define SIM_QUEUE_SLOT_ROTATING_POLICY_H_
+
+#include <vector>
+
+#include "sim/queue/IBufferPolicy.h"
+#include "sim/utils/IndexBitmap.h"
+
+// Places into the first free slot, serves slots round-robin and displaces
+// the most recently placed request
+class SlotRotatingPolicy final : public IBufferPolicy {
+ public:
+  explicit SlotRotatingPolicy(size_t capacity);
+
+  size_t place(RequestHandle request, size_t source_id) override;
+  std::pair<RequestHandle, size_t> take() override;
+  RequestHandle displace(size_t source_id) override;
+  void reset(size_t capacity) override;
+
+ private:
+  std::vector<RequestHandle> slots_;
+  // Slot occupancy, kept both ways so every rule is a find-next/prev
+  IndexBitmap occupied_;
+  IndexBitmap free_;
+  size_t capacity_;
+  size_t size_;
+  size_t place_start_;
+  size_t select_start_;
+};
+
+#endif  // SIM_QUEUE_SLOT_ROTATING_POLICY_H_
@@ -0,0 +1,47 @@
+#ifndef SIM_QUEUE_SOURCE_PRIORITY_POLICY_H_
+#define SIM_QUEUE_SOURCE_PRIORITY_POLICY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "sim/queue/IBufferPolicy.h"
+#include "sim/utils/IndexBitmap.h"
+
+// Priority by source: a lower source id is served first, FIFO within a
+// source. A full buffer displaces the newest request of the lowest-priority
+// source present, or refuses the arrival when its source has no higher
+// priority than that. Each source keeps an intrusive list through the slot
+// array and a bitmap tracks the non-empty sources.
+class SourcePriorityPolicy final : public IBufferPolicy {
+ public:
+  explicit SourcePriorityPolicy(size_t capacity);
+
+  size_t place(RequestHandle request, size_t source_id) override;
+  std::pair<RequestHandle, size_t> take() override;
+  RequestHandle displace(size_t source_id) override;
+  void reset(size_t capacity) override;
+
+ private:
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+  struct Slot {
+    RequestHandle request = NO_REQUEST;
+    uint32_t prev = NO_SLOT;
+    uint32_t next = NO_SLOT;
+  };
+
+  struct SourceList {
+    uint32_t head = NO_SLOT;  // oldest
+    uint32_t tail = NO_SLOT;  // newest
+  };
+
+  void add_sources(size_t count);
+  RequestHandle unlink(size_t source_id, uint32_t slot);
+
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  std::vector<SourceList> sources_;
+  IndexBitmap non_empty_;
+};
+
+#endif  // SIM_QUEUE_SOURCE_PRIORITY_POLICY_H_
@@ -0,0 +1,314 @@
+#ifndef SIM_SIMULATOR_BASIC_SIMULATOR_H_
+#define SIM_SIMULATOR_BASIC_SIMULATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "sim/queue/Buffer.h"
+#include "sim/device/DevicePool.h"
+#include "sim/event/Event.h"
+#include "sim/event/EventCalendar.h"
+#include "sim/event/EventDispatcher.h"
+#include "sim/metrics/Metrics.h"
+#include "sim/model/RequestPool.h"
+#include "sim/observers/ISimulationObserver.h"
+#include "sim/observers/MetricsObserver.h"
+#include "sim/simulator/ConfigurationManager.h"
+#include "sim/simulator/ISimulator.h"
+#include "sim/simulator/SimulationConfig.h"
+#include "sim/source/SourcePool.h"
+#include "sim/utils/HistogramCache.h"
+
+// Simulation kernel with the component types fixed at compile time; see
+// BasicEventDispatcher for the template parameters. The configuration must
+// select exactly those types (any, for the interface types), otherwise the
+// constructor and reconfigure() throw std::invalid_argument. Observers...
+// are default-constructed and notified without virtual calls. A Headless
+// kernel throws std::logic_error from add_observer().
+template <class Calendar, class BufferPolicy, class Strategy,
+          class ArrivalDist, class ServiceDist, bool Headless = false,
+          class... Observers>
+class BasicSimulator final : public ISimulator {
+ public:
+  using Dispatcher = BasicEventDispatcher<Calendar, BufferPolicy, Strategy,
+                                          ArrivalDist, ServiceDist, Headless,
+                                          Observers...>;
+
+  explicit BasicSimulator(const SimulationConfig& config)
+      : config_(validated(config)),
+        buffer_(config.buffer_capacity,
+                ConfigurationManager::create_buffer_policy(config)),
+        // Every live request sits in the buffer or on a device, plus the
+        // one arriving, so the pool never grows past this
+        request_pool_(config.buffer_capacity + config.devices.size() + 1),
+        calendar_(ConfigurationManager::create_event_calendar(config)),
+        device_pool_(
+            ConfigurationManager::create_device_pool(config, histograms_)),
+        source_pool_(
+            ConfigurationManager::create_source_pool(config, histograms_)),
+        static_observers_(make_static_observers(metrics_)),
+        dispatcher_(*source_pool_, *device_pool_, buffer_, request_pool_,
+                    calendar_, metrics_, config_, static_observers_),
+        current_time_(0.0),
+        event_count_(0) {
+    check_component_types();
+    dispatcher_.schedule_initial_arrivals(0.0);
+  }
+  // The dispatcher holds references into the simulator
+  BasicSimulator(const BasicSimulator&) = delete;
+  BasicSimulator& operator=(const BasicSimulator&) = delete;
+
+  void run() override {
+    while (!is_finished()) {
+      process_next_event();
+    }
+  }
+
+  void step() override { process_next_event(); }
+
+  void reset(uint32_t seed) override {
+    config_.seed = seed;
+    configure_pools();
+    restart();
+  }
+
+  void reconfigure(const SimulationConfig& config) override {
+    validated(config);
+
+    // The tournament backend is sized by the entity counts
+    bool new_calendar =
+        config.calendar_type != config_.calendar_type ||
+        (config.calendar_type == CalendarType::Tournament &&
+         (config.sources.size() != config_.sources.size() ||
+          config.devices.size() != config_.devices.size()));
+
+    bool new_buffer_policy =
+        config.buffer_discipline != config_.buffer_discipline;
+
+    config_ = config;
+    if (new_buffer_policy) {
+      buffer_.set_policy(config_.buffer_capacity,
+                         ConfigurationManager::create_buffer_policy(config_));
+    }
+    if (new_calendar) {
+      calendar_.set_backend(
+          ConfigurationManager::create_event_calendar(config_));
+    }
+    request_pool_.reserve(config_.buffer_capacity + config_.devices.size() +
+                          1);
+    configure_pools();
+    check_component_types();
+    restart();
+  }
+
+  const Metrics& get_metrics() const override { return metrics_; }
+  double get_current_time() const override { return current_time_; }
+  uint64_t get_event_count() const override { return event_count_; }
+
+  void add_observer(std::unique_ptr<ISimulationObserver> observer) override {
+    if constexpr (Headless) {
+      throw std::logic_error("Headless simulators take no observers");
+    } else {
+      dispatcher_.subscribe(*observer);
+      observers_.push_back(std::move(observer));
+    }
+  }
+
+  std::vector<std::unique_ptr<ISimulationObserver>> release_observers()
+      override {
+    dispatcher_.clear_subscribers();
+    auto observers = std::move(observers_);
+    observers_.clear();
+    return observers;
+  }
+
+  template <class Observer>
+  Observer& get_observer() {
+    return std::get<Observer>(static_observers_);
+  }
+
+  std::vector<bool> get_device_states() const override {
+    return device_pool_->get_device_states();
+  }
+
+  std::vector<double> get_source_next_event_times() const override {
+    return source_pool_->get_all_next_event_times();
+  }
+
+  std::vector<double> get_device_next_event_times() const override {
+    return device_pool_->get_all_next_event_times();
+  }
+
+  std::vector<bool> get_source_states() const override {
+    return source_pool_->get_source_states();
+  }
+
+  const Buffer& get_buffer() const override { return buffer_; }
+  const RequestPool& get_request_pool() const override {
+    return request_pool_;
+  }
+  const DevicePool& get_device_pool() const override { return *device_pool_; }
+  size_t get_calendar_size() const override {
+    return calendar_.get_size<Calendar>();
+  }
+
+  bool is_finished() const override {
+    if (current_time_ > config_.max_time) {
+      return true;
+    }
+
+    // Once every arrival has been generated, or every source has stopped,
+    // run until the calendar, the buffer and the devices have all drained
+    if (metrics_.get_arrived() < config_.max_arrivals &&
+        !calendar_.is_empty<Calendar>()) {
+      return false;
+    }
+    if (!calendar_.is_empty<Calendar>() || !buffer_.is_empty()) {
+      return false;
+    }
+    for (const auto& device : device_pool_->get_all_devices()) {
+      if (device && !device->is_free()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static const SimulationConfig& validated(const SimulationConfig& config) {
+    if (!ConfigurationManager::validate(config)) {
+      throw std::invalid_argument("Invalid simulation configuration");
+    }
+    ConfigurationManager::check_service_traces(config);
+    return config;
+  }
+
+  // MetricsObserver comes first unless the dispatcher records the metrics
+  static typename Dispatcher::StaticObservers make_static_observers(
+      Metrics& metrics) {
+    if constexpr (Headless) {
+      return {Observers()...};
+    } else {
+      return {MetricsObserver(metrics), Observers()...};
+    }
+  }
+
+  // A step dispatches every event scheduled at the next event time,
+  // including those scheduled for that same instant meanwhile
+  bool process_next_event() {
+    if (calendar_.is_empty<Calendar>()) {
+      return false;
+    }
+
+    current_time_ = calendar_.get_next_time<Calendar>();
+    if (current_time_ > config_.max_time) {
+      return false;
+    }
+
+    // Drain the whole timestamp as one batch; the calendar hands equal-time
+    // events back in the order they were scheduled, those scheduled for
+    // this instant while dispatching after the rest.
+    size_t event_count = 0;
+    do {
+      batch_.clear();
+      calendar_.pop_batch<Calendar>(batch_);
+      for (const Event& event : batch_) {
+        dispatch(event);
+      }
+      dispatcher_.insert_scheduled();
+      event_count += batch_.size();
+    } while (calendar_.get_next_time<Calendar>() == current_time_);
+    event_count_ += event_count;
+    dispatcher_.handle_batch_end(event_count, current_time_);
+
+    return true;
+  }
+
+  void dispatch(const Event& event) {
+    switch (event.get_type()) {
+      case EventType::arrival:
+        dispatcher_.handle_arrival(event.get_source_id(), current_time_);
+        break;
+      case EventType::service_end: {
+        Device& device = device_pool_->get_device(event.get_device_id());
+        dispatcher_.handle_service_end(&device, current_time_);
+        break;
+      }
+    }
+  }
+
+  void configure_pools() {
+    ConfigurationManager::configure_device_pool(*device_pool_, config_,
+                                                histograms_);
+    ConfigurationManager::configure_source_pool(*source_pool_, config_,
+                                                histograms_);
+    histograms_.release_unused();
+  }
+
+  void restart() {
+    calendar_.clear();
+    buffer_.reset(config_.buffer_capacity);
+    request_pool_.clear();
+    metrics_.reset();
+    device_pool_->reset();
+    source_pool_->reset();
+    current_time_ = 0.0;
+    event_count_ = 0;
+    dispatcher_.schedule_initial_arrivals(0.0);
+  }
+
+  // The hot paths cast the components to the template types unchecked
+  void check_component_types() {
+    bool matches =
+        dynamic_cast<const Calendar*>(&calendar_.get_backend()) != nullptr &&
+        dynamic_cast<const BufferPolicy*>(&buffer_.get_policy()) != nullptr &&
+        dynamic_cast<const Strategy*>(&device_pool_->get_strategy()) !=
+            nullptr;
+    for (const auto& source : source_pool_->get_all_sources()) {
+      matches = matches && dynamic_cast<const ArrivalDist*>(
+                               &source->get_distribution()) != nullptr;
+    }
+    for (const auto& device : device_pool_->get_all_devices()) {
+      matches = matches && dynamic_cast<const ServiceDist*>(
+                               &device->get_distribution()) != nullptr;
+    }
+    if (!matches) {
+      throw std::invalid_argument(
+          "Configuration does not match the simulator component types");
+    }
+  }
+
+  SimulationConfig config_;
+
+  // Core components
+  Buffer buffer_;
+  RequestPool request_pool_;
+  Metrics metrics_;
+  EventCalendar calendar_;
+  // Shared by the empirical distributions of both pools
+  HistogramCache histograms_;
+  std::unique_ptr<DevicePool> device_pool_;
+  std::unique_ptr<SourcePool> source_pool_;
+
+  // Observers
+  typename Dispatcher::StaticObservers static_observers_;
+  std::vector<std::unique_ptr<ISimulationObserver>> observers_;
+
+  Dispatcher dispatcher_;
+
+  // Simulation state
+  double current_time_;
+  uint64_t event_count_;
+  std::vector<Event> batch_;
+};
+
+// Kernel going through the component interfaces, for any configuration
+using DynamicSimulator =
+    BasicSimulator<IEventCalendar, IBufferPolicy, IDeviceSelectionStrategy,
+                   IDistribution, IDistribution>;
+
+#endif  // SIM_SIMULATOR_BASIC_SIMULATOR_H_
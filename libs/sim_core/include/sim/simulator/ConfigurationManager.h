@@ -2,29 +2,73 @@
 #define SIM_SIMULATOR_CONFIGURATION_MANAGER_H_
 
 #include <memory>
+#include <string>
 
 #include "sim/device/DevicePool.h"
 #include "sim/device/IDeviceSelectionStrategy.h"
+#include "sim/event/IEventCalendar.h"
+#include "sim/queue/IBufferPolicy.h"
 #include "sim/simulator/SimulationConfig.h"
 #include "sim/source/SourcePool.h"
+#include "sim/utils/HistogramCache.h"
 #include "sim/utils/IDistribution.h"
+#include "sim/utils/IRandomEngine.h"
+#include "sim/utils/StreamId.h"
 
 class ConfigurationManager {
  public:
   static bool validate(const SimulationConfig& config);
+  // Throws std::invalid_argument if a device's service trace cannot last
+  // the run. One that does not loop must hold a service time for every
+  // arrival, as any one device may serve them all. Devices replaying the
+  // same file each take a slice of it (see TraceDistribution), in device
+  // order.
+  static void check_service_traces(const SimulationConfig& config);
 
-  // Create device selection strategy (currently only round-robin)
+  // Create the device selection strategy named by config.device_selection
   static std::unique_ptr<IDeviceSelectionStrategy>
   create_device_selection_strategy(const SimulationConfig& config);
 
+  // Empirical distributions get their histograms from histograms
   static std::unique_ptr<DevicePool> create_device_pool(
-      const SimulationConfig& config);
+      const SimulationConfig& config, HistogramCache& histograms);
 
   static std::unique_ptr<SourcePool> create_source_pool(
+      const SimulationConfig& config, HistogramCache& histograms);
+
+  // Bring an existing pool in line with config. Entities and distributions
+  // are reused when their type matches and reseeded as create_* would.
+  static void configure_device_pool(DevicePool& pool,
+                                    const SimulationConfig& config,
+                                    HistogramCache& histograms);
+  static void configure_source_pool(SourcePool& pool,
+                                    const SimulationConfig& config,
+                                    HistogramCache& histograms);
+
+  static std::unique_ptr<IEventCalendar> create_event_calendar(
       const SimulationConfig& config);
 
+  static std::unique_ptr<IBufferPolicy> create_buffer_policy(
+      const SimulationConfig& config);
+
+  // The random stream of entity id of the given kind. Streams differ for
+  // every (seed, replication, kind, id), so sources and devices with equal
+  // ids, or runs with nearby seeds, never share random numbers.
+  static StreamId get_stream_id(const SimulationConfig& config,
+                                StreamKind kind, size_t id);
+
+  static std::unique_ptr<IRandomEngine> create_random_engine(
+      RngType type, const StreamId& stream);
+
+  // path names the file of the Empirical and Trace* types; the Trace*
+  // types start over at its end if loop is set. Empirical histograms come
+  // from histograms, or are read afresh without one.
   static std::unique_ptr<IDistribution> create_distribution(
-      DistributionType type, double param, uint32_t seed = 0);
+      DistributionType type, double param, double shape = 1.0,
+      const StreamId& stream = {},
+      RngType rng_type = RngType::Xoshiro256PlusPlus,
+      const std::string& path = {}, bool loop = false,
+      HistogramCache* histograms = nullptr);
 };
 
 #endif  // SIM_SIMULATOR_CONFIGURATION_MANAGER_H_
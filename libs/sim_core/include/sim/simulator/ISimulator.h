@@ -0,0 +1,50 @@
+#ifndef SIM_SIMULATOR_I_SIMULATOR_H_
+#define SIM_SIMULATOR_I_SIMULATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "sim/queue/Buffer.h"
+#include "sim/device/DevicePool.h"
+#include "sim/metrics/Metrics.h"
+#include "sim/model/RequestPool.h"
+#include "sim/observers/ISimulationObserver.h"
+#include "sim/simulator/SimulationConfig.h"
+
+// Simulation kernel, implemented by the BasicSimulator instantiations; see
+// Simulator for the meaning of each call
+class ISimulator {
+ public:
+  virtual ~ISimulator() = default;
+
+  virtual void run() = 0;
+  virtual void step() = 0;
+  virtual void reset(uint32_t seed) = 0;
+  virtual void reconfigure(const SimulationConfig& config) = 0;
+
+  virtual const Metrics& get_metrics() const = 0;
+  virtual double get_current_time() const = 0;
+  virtual uint64_t get_event_count() const = 0;
+
+  // The observer's subscriptions are read here
+  virtual void add_observer(std::unique_ptr<ISimulationObserver> observer) = 0;
+  // Detaches and returns the observers added with add_observer
+  virtual std::vector<std::unique_ptr<ISimulationObserver>>
+  release_observers() = 0;
+
+  virtual std::vector<bool> get_device_states() const = 0;
+  virtual std::vector<double> get_source_next_event_times() const = 0;
+  virtual std::vector<double> get_device_next_event_times() const = 0;
+  virtual std::vector<bool> get_source_states() const = 0;
+
+  virtual const Buffer& get_buffer() const = 0;
+  virtual const RequestPool& get_request_pool() const = 0;
+  virtual const DevicePool& get_device_pool() const = 0;
+  virtual size_t get_calendar_size() const = 0;
+
+  virtual bool is_finished() const = 0;
+};
+
+#endif  // SIM_SIMULATOR_I_SIMULATOR_H_
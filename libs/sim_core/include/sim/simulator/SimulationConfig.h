@@ -3,23 +3,79 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
+// The parameter of every random distribution is its intensity, 1 / mean;
+// the shape, where there is one, is noted per type. The Empirical and
+// Trace* types read the entity's file.
 enum class DistributionType {
-  Constant,     // Constant intervals
-  Exponential   // Exponential distribution
+  Constant,          // Constant intervals
+  Exponential,       // Exponential distribution
+  Erlang,            // shape: number of phases, >= 1
+  Hyperexponential,  // shape: squared coefficient of variation, >= 1
+  Lognormal,         // shape: standard deviation of the logarithm, > 0
+  Pareto,            // shape: tail index, > 1
+  Uniform,           // shape: half width relative to the mean, in [0, 1]
+  Weibull,           // shape: Weibull shape k, > 0
+  TruncatedNormal,   // shape: standard deviation over location, > 0
+  Empirical,         // histogram file (see Histogram), rescaled; no shape
+  TraceIntervals,    // trace timestamps (see TraceDistribution); the
+                     // parameter is the playback rate. The source stops
+                     // at the end of the trace unless it loops.
+  TraceServiceTimes  // trace service-time column; as TraceIntervals, but
+                     // running out of it throws
+};
+
+enum class CalendarType {
+  BinaryHeap,     // std::push_heap/pop_heap over a vector, O(log n)
+  CalendarQueue,  // Brown's calendar queue, O(1) amortized
+  LadderQueue,    // Tang's ladder queue, O(1) amortized on skewed times
+  Tournament      // one slot per source/device in a winner tree, O(log n)
+};
+
+enum class BufferDiscipline {
+  SlotRotating,    // first free slot, round-robin service, displace newest
+  Fifo,            // ring buffer, oldest first, displace newest
+  Lifo,            // stack, newest first, displace newest
+  SourcePriority,  // lower source id first, displace lowest priority newest
+  DisplaceOldest   // ring buffer, oldest first, displace oldest
+};
+
+enum class DeviceSelection {
+  RoundRobin,     // next free device after the last one chosen
+  FastestFree,    // free device with the shortest mean service time
+  LeastBusyTime,  // free device with the least cumulative busy time
+  FixedPriority,  // free device with the lowest id
+  Random          // uniformly random free device
+};
+
+enum class RngType {
+  Xoshiro256PlusPlus,  // xoshiro256++, 32 bytes of state
+  Pcg64,               // PCG XSL RR 128/64, 16 bytes of state
+  SplitMix64,          // SplitMix64, 8 bytes of state
+  Philox4x32,          // Philox4x32-10, counter-based, O(1) discard
+  Mt19937              // std::mt19937, 2.5 KB
 };
 
 struct SourceConfig {
   size_t id;
   double arrival_parameter;
   DistributionType arrival_distribution_type = DistributionType::Constant;
+  double arrival_shape = 1.0;
+  std::string arrival_file = {};
+  // Trace* types: start the trace over at its end
+  bool loop_arrival_file = false;
 };
 
 struct DeviceConfig {
   size_t id;
   double service_parameter;
   DistributionType service_distribution_type = DistributionType::Exponential;
+  double service_shape = 1.0;
+  // Devices naming the same trace each replay their own slice of it
+  std::string service_file = {};
+  bool loop_service_file = false;  // as loop_arrival_file
 };
 
 struct SimulationConfig {
@@ -27,8 +83,19 @@ struct SimulationConfig {
   size_t max_arrivals;
   double max_time = 1e9;
   uint32_t seed;
+  // Independent run of the same configuration and seed; every entity's
+  // stream is keyed on (seed, replication)
+  uint32_t replication = 0;
   std::vector<SourceConfig> sources;
   std::vector<DeviceConfig> devices;
+  CalendarType calendar_type = CalendarType::BinaryHeap;
+  BufferDiscipline buffer_discipline = BufferDiscipline::SlotRotating;
+  DeviceSelection device_selection = DeviceSelection::RoundRobin;
+  // Engine behind every source's and device's random stream
+  RngType rng_type = RngType::Xoshiro256PlusPlus;
+  // Batch runs: metrics are recorded by the dispatcher itself and no
+  // observers can be attached. Results are the same either way.
+  bool headless = false;
 };
 
 #endif  // SIM_SIMULATOR_SIMULATION_CONFIG_H_
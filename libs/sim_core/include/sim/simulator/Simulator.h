@@ -2,33 +2,47 @@
 #define SIM_SIMULATOR_SIMULATOR_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "sim/queue/Buffer.h"
 #include "sim/device/DevicePool.h"
-#include "sim/event/Event.h"
-#include "sim/event/EventCalendar.h"
-#include "sim/event/EventDispatcher.h"
 #include "sim/metrics/Metrics.h"
+#include "sim/model/RequestPool.h"
+#include "sim/simulator/ISimulator.h"
 #include "sim/simulator/SimulationConfig.h"
-#include "sim/source/SourcePool.h"
 #include "sim/observers/ISimulationObserver.h"
 
+// Runs the BasicSimulator instantiation matching the configuration: common
+// configurations get a kernel with concrete component types, the rest the
+// DynamicSimulator, in either case a headless one if the configuration asks
+// for it. Results do not depend on which kernel runs.
 class Simulator {
  public:
   explicit Simulator(const SimulationConfig& config);
   ~Simulator() = default;
 
-  // Simulation control
-  void run();
-  void step();
+  // Simulation control. A step dispatches every event scheduled at the next
+  // event time, including those scheduled for that same instant meanwhile.
+  void run() { kernel_->run(); }
+  void step() { kernel_->step(); }
+
+  // Rewind to time 0 with a new seed, or with a new configuration, reusing
+  // the existing pools, buffer and calendar storage where sizes allow.
+  // Attached observers stay attached. The run that follows matches a freshly
+  // constructed Simulator with the same configuration.
+  void reset(uint32_t seed);
+  void reconfigure(const SimulationConfig& config);
 
   // Metrics and state queries
-  Metrics get_metrics() const { return metrics_; }
-  double get_current_time() const { return current_time_; }
+  Metrics get_metrics() const { return kernel_->get_metrics(); }
+  double get_current_time() const { return kernel_->get_current_time(); }
+  // Events dispatched since time 0
+  uint64_t get_event_count() const { return kernel_->get_event_count(); }
 
-  // Observer management
+  // Observer management. Headless simulators throw std::logic_error, also
+  // from reconfigure() into headless mode with observers attached.
   void add_observer(std::unique_ptr<ISimulationObserver> observer);
 
   // State query methods for UI
@@ -38,31 +52,25 @@ class Simulator {
   std::vector<bool> get_source_states() const;
 
   // Query methods for state inspection
-  const Buffer& get_buffer() const { return buffer_; }
-  const DevicePool& get_device_pool() const { return *device_pool_; }
-  size_t get_calendar_size() const { return calendar_.get_size(); }
+  const Buffer& get_buffer() const { return kernel_->get_buffer(); }
+  const RequestPool& get_request_pool() const {
+    return kernel_->get_request_pool();
+  }
+  const DevicePool& get_device_pool() const {
+    return kernel_->get_device_pool();
+  }
+  size_t get_calendar_size() const { return kernel_->get_calendar_size(); }
 
-  bool is_finished() const;
+  bool is_finished() const { return kernel_->is_finished(); }
 
  private:
-  SimulationConfig config_;
-
-  // Core components
-  Buffer buffer_;
-  Metrics metrics_;
-  EventCalendar calendar_;
-  std::unique_ptr<DevicePool> device_pool_;
-  std::unique_ptr<SourcePool> source_pool_;
-  std::unique_ptr<EventDispatcher> dispatcher_;
-
-  // Simulation state
-  double current_time_;
+  using KernelFactory =
+      std::unique_ptr<ISimulator> (*)(const SimulationConfig& config);
 
-  // Observers
-  std::vector<std::unique_ptr<ISimulationObserver>> observers_;
+  static KernelFactory select_kernel(const SimulationConfig& config);
 
-  // Helper methods
-  bool process_next_event();
+  KernelFactory kernel_factory_;
+  std::unique_ptr<ISimulator> kernel_;
 };
 
 #endif  // SIM_SIMULATOR_SIMULATOR_H_
@@ -1,26 +1,45 @@
 #ifndef SIM_SOURCE_SOURCE_H_
 #define SIM_SOURCE_SOURCE_H_
 
+#include <cmath>
 #include <cstddef>
 #include <memory>
 
 #include "sim/utils/IDistribution.h"
+#include "sim/utils/VariateBlock.h"
 
 class Source {
  public:
   static constexpr double NO_EVENT_TIME = -1.0;
 
   Source(size_t id, std::unique_ptr<IDistribution> distribution);
-  
-  double schedule_next_arrival(double current_time);
+
+  // Distribution may name the concrete (final) type of the distribution
+  // held, which turns the draw into a direct call. An infinite interval,
+  // as an exhausted trace gives, stops the source: NO_EVENT_TIME.
+  template <class Distribution = IDistribution>
+  double schedule_next_arrival(double current_time) {
+    double interval =
+        variates_.next<Distribution>(*arrival_distribution_);
+    next_arrival_time_ =
+        std::isinf(interval) ? NO_EVENT_TIME : current_time + interval;
+    return next_arrival_time_;
+  }
   double get_next_arrival_time() const;
   void clear_next_arrival_time();
   bool is_active() const;
   size_t get_id() const;
 
+  IDistribution& get_distribution();
+  void set_distribution(std::unique_ptr<IDistribution> distribution);
+  // Returns to the just-constructed state and drops the prefetched
+  // variates; the distribution itself is untouched
+  void reset();
+
  private:
   size_t id_;
   std::unique_ptr<IDistribution> arrival_distribution_;
+  VariateBlock variates_;
   double next_arrival_time_;
 };
 
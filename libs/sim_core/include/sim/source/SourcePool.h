@@ -18,6 +18,9 @@ class SourcePool {
   std::vector<bool> get_source_states() const;
   std::vector<double> get_all_next_event_times() const;
   size_t size() const;
+  // Drops the sources with id >= count
+  void truncate(size_t count);
+  void reset();
 
  private:
   std::vector<std::unique_ptr<Source>> sources_;
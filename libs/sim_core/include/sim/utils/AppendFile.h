@@ -0,0 +1,60 @@
+#ifndef SIM_UTILS_APPEND_FILE_H_
+#define SIM_UTILS_APPEND_FILE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// File written front to back through a buffer of its own, handed to the
+// OS a buffer at a time. The buffer is reused, so it stays in cache, and
+// a full disk fails the write that finds it rather than a later store.
+class AppendFile {
+ public:
+  // Creates the file, or truncates it. Throws std::runtime_error if it
+  // cannot be opened.
+  explicit AppendFile(const std::string& path);
+  // Closes the file, ignoring errors
+  ~AppendFile();
+  AppendFile(const AppendFile&) = delete;
+  AppendFile& operator=(const AppendFile&) = delete;
+
+  // Space for length bytes at the end of the file, added to it by
+  // commit(); valid until the next reserve() or append(). Throws
+  // std::runtime_error if what is buffered cannot be written,
+  // std::logic_error once closed.
+  std::byte* reserve(size_t length);
+  void commit(size_t length) {
+    used_ += length;
+    size_ += length;
+  }
+  void append(const void* data, size_t length);
+
+  size_t get_size() const { return size_; }
+
+  // Writes what is buffered and closes the file; further writes throw.
+  // Throws std::runtime_error if the buffer cannot be written.
+  void close();
+
+ private:
+  // Bytes buffered at a time, unless a single reserve() asks for more
+  static constexpr size_t BUFFER_BYTES = size_t{1} << 20;
+
+  // Writes the buffer out and empties it
+  void flush();
+  // Hands length bytes to the OS; false if not all of them were written
+  bool write(const std::byte* data, size_t length);
+  void close_file();
+
+  std::string path_;
+  std::unique_ptr<std::byte[]> buffer_;
+  size_t capacity_;
+  size_t used_;
+  size_t size_;
+#ifdef _WIN32
+  void* file_;
+#else
+  int file_;
+#endif
+};
+
+#endif  // SIM_UTILS_APPEND_FILE_H_
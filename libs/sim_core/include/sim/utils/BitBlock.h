@@ -0,0 +1,39 @@
+#ifndef SIM_UTILS_BIT_BLOCK_H_
+#define SIM_UTILS_BIT_BLOCK_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "sim/utils/IRandomEngine.h"
+
+// Random words prefetched from an engine with one fill_bits() call per
+// block. Samplers that need a varying number of draws per variate take all
+// of them from here, so their stream does not depend on how the variates
+// are split into fill() calls.
+class BitBlock {
+ public:
+  static constexpr size_t SIZE = 16;
+
+  uint64_t next(IRandomEngine& engine) {
+    if (position_ == SIZE) {
+      engine.fill_bits(words_);
+      position_ = 0;
+    }
+    return words_[position_++];
+  }
+
+  // Uniform on (0, 1] from the top 53 bits of the next word
+  double next_uniform(IRandomEngine& engine) {
+    return static_cast<double>((next(engine) >> 11) + 1) * 0x1.0p-53;
+  }
+
+  // Drops the words not consumed yet, e.g. after the engine was reseeded
+  void clear() { position_ = SIZE; }
+
+ private:
+  std::array<uint64_t, SIZE> words_;
+  size_t position_ = SIZE;
+};
+
+#endif  // SIM_UTILS_BIT_BLOCK_H_
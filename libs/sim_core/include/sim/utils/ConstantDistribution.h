@@ -3,11 +3,13 @@
 
 #include "sim/utils/IDistribution.h"
 
-class ConstantDistribution : public IDistribution {
+class ConstantDistribution final : public IDistribution {
  public:
   explicit ConstantDistribution(double constant_value);
   ~ConstantDistribution() override = default;
   double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
 
  private:
   double constant_value_;
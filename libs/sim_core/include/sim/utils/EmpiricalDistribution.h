@@ -0,0 +1,42 @@
+#ifndef SIM_UTILS_EMPIRICAL_DISTRIBUTION_H_
+#define SIM_UTILS_EMPIRICAL_DISTRIBUTION_H_
+
+#include <memory>
+#include <string>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/Histogram.h"
+#include "sim/utils/RandomDistribution.h"
+
+// Samples a measured histogram rescaled to mean 1 / intensity; with the
+// intensity set to 1 / histogram mean the recorded values come out as is.
+// Distributions given the same histogram share it.
+class EmpiricalDistribution final : public RandomDistribution {
+ public:
+  // histogram was read from histogram_path
+  EmpiricalDistribution(double intensity, const std::string& histogram_path,
+                        std::shared_ptr<const Histogram> histogram,
+                        std::unique_ptr<IRandomEngine> engine);
+  ~EmpiricalDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void reseed(const StreamId& stream) override;
+
+  const std::string& get_histogram_path() const { return histogram_path_; }
+  const Histogram& get_histogram() const { return *histogram_; }
+
+ private:
+  double sample() {
+    uint64_t bin_bits = bits_.next(*engine_);
+    uint64_t position_bits = bits_.next(*engine_);
+    return histogram_->sample(bin_bits, position_bits) * scale_;
+  }
+
+  std::string histogram_path_;
+  std::shared_ptr<const Histogram> histogram_;
+  double scale_;
+  BitBlock bits_;
+};
+
+#endif  // SIM_UTILS_EMPIRICAL_DISTRIBUTION_H_
@@ -0,0 +1,31 @@
+#ifndef SIM_UTILS_ERLANG_DISTRIBUTION_H_
+#define SIM_UTILS_ERLANG_DISTRIBUTION_H_
+
+#include <cstddef>
+#include <memory>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/RandomDistribution.h"
+
+// Sum of k = round(shape) exponential phases with mean 1 / (k * intensity)
+// each: mean 1 / intensity, squared coefficient of variation 1 / k
+class ErlangDistribution final : public RandomDistribution {
+ public:
+  ErlangDistribution(double intensity, double shape,
+                     std::unique_ptr<IRandomEngine> engine);
+  ~ErlangDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+  void reseed(const StreamId& stream) override;
+
+ private:
+  double sample();
+
+  double mean_;
+  size_t stages_;
+  BitBlock bits_;
+};
+
+#endif  // SIM_UTILS_ERLANG_DISTRIBUTION_H_
@@ -0,0 +1,74 @@
+#ifndef SIM_UTILS_EVENT_TRACE_READER_H_
+#define SIM_UTILS_EVENT_TRACE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/event/EventTrace.h"
+#include "sim/utils/MappedFile.h"
+
+// Reads a trace written by EventTraceObserver out of a memory mapping. A
+// sparse index, one entry per chunk, finds any record or time by decoding
+// at most one chunk; only the pages read are loaded. Traces cut short
+// before their index are read up to the last complete chunk.
+class EventTraceReader {
+ public:
+  // Decodes the records one after the other from where it was placed.
+  // Valid while its reader is.
+  class Cursor {
+   public:
+    // Returns false past the last record
+    bool next(TraceRecord& record);
+    // Index of the record next() returns next
+    uint64_t get_position() const { return position_; }
+
+   private:
+    friend class EventTraceReader;
+
+    Cursor(const EventTraceReader& reader, size_t chunk);
+    bool load_chunk(size_t chunk);
+    unsigned read_tag();
+    uint64_t read_field(unsigned length);
+
+    const EventTraceReader* reader_;
+    size_t chunk_;
+    // The next record, the end of the chunk and the end of the file
+    const std::byte* in_;
+    const std::byte* end_;
+    const std::byte* limit_;
+    size_t chunk_remaining_;
+    uint64_t position_;
+    uint64_t time_bits_;
+    uint64_t request_id_;
+  };
+
+  // Throws std::runtime_error if the file cannot be mapped and
+  // std::invalid_argument if it is not an event trace
+  explicit EventTraceReader(const std::string& path);
+
+  uint64_t get_record_count() const { return record_count_; }
+  size_t get_chunk_count() const { return index_.size(); }
+  // Whether the index was written, as it is when tracing finished normally
+  bool is_complete() const { return complete_; }
+
+  // Placed at the record with the given index, or at the end
+  Cursor seek(uint64_t record) const;
+  // Placed at the first record at or after time. Times must not decrease
+  // through the trace, as they do not within one run.
+  Cursor seek_time(double time) const;
+
+ private:
+  bool read_index();
+  void scan_chunks();
+  EventTrace::ChunkHeader get_chunk_header(size_t chunk) const;
+
+  MappedFile file_;
+  std::string path_;
+  std::vector<EventTrace::IndexEntry> index_;
+  uint64_t record_count_;
+  bool complete_;
+};
+
+#endif  // SIM_UTILS_EVENT_TRACE_READER_H_
@@ -1,20 +1,22 @@
 #ifndef SIM_UTILS_EXPONENTIAL_DISTRIBUTION_H_
 #define SIM_UTILS_EXPONENTIAL_DISTRIBUTION_H_
 
-#include "sim/utils/IDistribution.h"
-#include <cstdint>
-#include <random>
+#include "sim/utils/RandomDistribution.h"
+#include <memory>
 
-class ExponentialDistribution : public IDistribution {
+// Inversion sampler: -log(u) / intensity for u uniform on (0, 1] with 53
+// random bits, the logarithm taken a block at a time by VectorMath
+class ExponentialDistribution final : public RandomDistribution {
  public:
-  ExponentialDistribution(double intensity, uint32_t seed);
+  ExponentialDistribution(double intensity,
+                          std::unique_ptr<IRandomEngine> engine);
   ~ExponentialDistribution() override = default;
   double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
 
  private:
-  std::mt19937 rng_;
-  std::exponential_distribution<double> dist_;
+  double mean_;
 };
 
 #endif  // SIM_UTILS_EXPONENTIAL_DISTRIBUTION_H_
-
@@ -0,0 +1,92 @@
+#ifndef SIM_UTILS_HISTOGRAM_H_
+#define SIM_UTILS_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+// Piecewise-uniform distribution over weighted bins [lower, upper), sampled
+// in O(1) with Vose's alias table: one random word picks a bin, another
+// the position inside it. Bins may leave gaps and need not be sorted.
+//
+// Files are read as either
+//   binary: "SIMHIST1", uint64 bin count, then per bin the doubles lower,
+//           upper and weight, all in host byte order;
+//   text:   one "lower,upper,weight" line per bin, separated by commas,
+//           semicolons or blanks, with '#' comments and an optional header.
+class Histogram {
+ public:
+  // Throws std::invalid_argument unless every bin has 0 <= lower <= upper
+  // and weight >= 0, and the total weight and the mean are positive
+  Histogram(const std::vector<double>& lower, const std::vector<double>& upper,
+            const std::vector<double>& weights);
+
+  // Throws std::runtime_error if the file cannot be read and
+  // std::invalid_argument if it is malformed
+  static Histogram read(const std::string& path);
+
+  // Value for two uniformly random words
+  double sample(uint64_t bin_bits, uint64_t position_bits) const {
+    return get_value(get_bin(bin_bits), position_bits);
+  }
+
+  // The steps of sample(), for callers that prefetch between them. A
+  // column is get_bin() before the alias coin is tossed.
+  size_t get_column(uint64_t bin_bits) const {
+    return static_cast<size_t>(column_product(bin_bits) >> 32);
+  }
+  size_t get_bin(uint64_t bin_bits) const {
+    uint64_t product = column_product(bin_bits);
+    const Bin& column = bins_[product >> 32];
+    return static_cast<uint32_t>(product) < column.threshold
+               ? static_cast<size_t>(product >> 32)
+               : column.alias;
+  }
+  double get_value(size_t bin, uint64_t position_bits) const {
+    double position = static_cast<double>(position_bits >> 11) * 0x1.0p-53;
+    return bins_[bin].lower + bins_[bin].width * position;
+  }
+  void prefetch(size_t bin) const {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&bins_[bin]);
+#elif defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(reinterpret_cast<const char*>(&bins_[bin]), _MM_HINT_T0);
+#endif
+  }
+
+  size_t get_size() const { return bins_.size(); }
+  double get_mean() const { return mean_; }
+  // Heap bytes held by the tables
+  size_t get_memory_bytes() const;
+
+ private:
+  // A column of the alias table: this bin with probability
+  // threshold / 2^32, the alias bin otherwise. One record per column keeps
+  // a draw to one or two cache lines.
+  struct Bin {
+    double lower;
+    double width;
+    uint32_t threshold;
+    uint32_t alias;
+  };
+
+  // Top 64 of the 96 bits of bin_bits * size: the column above the alias
+  // coin
+  uint64_t column_product(uint64_t bin_bits) const {
+    uint64_t count = bins_.size();
+    uint64_t low = (bin_bits & 0xffffffffull) * count;
+    return (bin_bits >> 32) * count + (low >> 32);
+  }
+
+  void build_alias_table(const std::vector<double>& weights);
+
+  std::vector<Bin> bins_;
+  double mean_;
+};
+
+#endif  // SIM_UTILS_HISTOGRAM_H_
@@ -0,0 +1,24 @@
+#ifndef SIM_UTILS_HISTOGRAM_CACHE_H_
+#define SIM_UTILS_HISTOGRAM_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "sim/utils/Histogram.h"
+
+// Histograms loaded by one simulator, shared by its distributions reading
+// the same file. A file is read again once no distribution holds it.
+class HistogramCache {
+ public:
+  // Reads the file unless it is already held. Throws as Histogram::read().
+  std::shared_ptr<const Histogram> load(const std::string& path);
+  // Drops the histograms no distribution holds any more
+  void release_unused();
+
+ private:
+  std::unordered_map<std::string, std::shared_ptr<const Histogram>>
+      histograms_;
+};
+
+#endif  // SIM_UTILS_HISTOGRAM_CACHE_H_
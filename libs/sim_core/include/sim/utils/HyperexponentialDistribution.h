@@ -0,0 +1,34 @@
+#ifndef SIM_UTILS_HYPEREXPONENTIAL_DISTRIBUTION_H_
+#define SIM_UTILS_HYPEREXPONENTIAL_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/RandomDistribution.h"
+
+// Two exponential branches with balanced means (Whitt): mean
+// 1 / intensity and squared coefficient of variation shape >= 1
+class HyperexponentialDistribution final : public RandomDistribution {
+ public:
+  HyperexponentialDistribution(double intensity, double shape,
+                               std::unique_ptr<IRandomEngine> engine);
+  ~HyperexponentialDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+  void reseed(const StreamId& stream) override;
+
+ private:
+  void update();
+  double sample();
+
+  double mean_;
+  double scv_;
+  double first_probability_;
+  double first_mean_;
+  double second_mean_;
+  BitBlock bits_;
+};
+
+#endif  // SIM_UTILS_HYPEREXPONENTIAL_DISTRIBUTION_H_
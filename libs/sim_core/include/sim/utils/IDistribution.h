@@ -1,10 +1,28 @@
 #ifndef SIM_UTILS_I_DISTRIBUTION_H_
 #define SIM_UTILS_I_DISTRIBUTION_H_
 
+#include <cstdint>
+#include <span>
+
+#include "sim/utils/StreamId.h"
+
 class IDistribution {
  public:
   virtual ~IDistribution() = default;
   virtual double generate() = 0;
+  // Writes the next values.size() variates, the same ones as that many
+  // generate() calls would return
+  virtual void fill(std::span<double> values) {
+    for (double& value : values) {
+      value = generate();
+    }
+  }
+  // Changes the distribution parameter (constant value or intensity)
+  virtual void set_parameter(double param) = 0;
+  // Changes the shape of two-parameter families; see DistributionType
+  virtual void set_shape(double /*shape*/) {}
+  // Restarts at the beginning of the given random stream
+  virtual void reseed(const StreamId& /*stream*/) {}
 };
 
 #endif  // SIM_UTILS_I_DISTRIBUTION_H_
@@ -0,0 +1,24 @@
+#ifndef SIM_UTILS_I_RANDOM_ENGINE_H_
+#define SIM_UTILS_I_RANDOM_ENGINE_H_
+
+#include <cstdint>
+#include <span>
+
+#include "sim/utils/StreamId.h"
+
+// Source of uniform variates for the samplers
+class IRandomEngine {
+ public:
+  virtual ~IRandomEngine() = default;
+  // Uniform on (0, 1] with 53 random bits; never 0, so its log is finite
+  virtual double next_uniform() = 0;
+  // Writes the next values.size() uniforms, as next_uniform() would
+  virtual void fill_uniform(std::span<double> values) = 0;
+  // 64 uniformly random bits, for samplers that split them up
+  virtual uint64_t next_bits() = 0;
+  virtual void fill_bits(std::span<uint64_t> values) = 0;
+  // Restarts at the beginning of the given stream
+  virtual void seed(const StreamId& stream) = 0;
+};
+
+#endif  // SIM_UTILS_I_RANDOM_ENGINE_H_
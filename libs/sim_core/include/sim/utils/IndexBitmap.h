@@ -0,0 +1,37 @@
+#ifndef SIM_UTILS_INDEX_BITMAP_H_
+#define SIM_UTILS_INDEX_BITMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size set of indices stored as a hierarchy of 64-bit words: bit j of
+// a word at level k + 1 is set when word j of level k is non-zero. Set and
+// reset cost O(log64 n); finding the next or previous member skips empty
+// words through the summary levels, so it costs O(log64 n) as well.
+class IndexBitmap {
+ public:
+  static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+  explicit IndexBitmap(size_t size = 0, bool value = false);
+
+  // Resizes to size indices, all set to value; reuses the word storage
+  void assign(size_t size, bool value);
+
+  void set(size_t index);
+  void reset(size_t index);
+  bool test(size_t index) const;
+
+  // First member >= from, or NPOS
+  size_t find_next(size_t from) const;
+  // Last member <= from, or NPOS; from >= size() searches the whole set
+  size_t find_prev(size_t from) const;
+
+  size_t size() const;
+
+ private:
+  std::vector<std::vector<uint64_t>> levels_;
+  size_t size_;
+};
+
+#endif  // SIM_UTILS_INDEX_BITMAP_H_
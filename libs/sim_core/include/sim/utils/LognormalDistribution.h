@@ -0,0 +1,31 @@
+#ifndef SIM_UTILS_LOGNORMAL_DISTRIBUTION_H_
+#define SIM_UTILS_LOGNORMAL_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/RandomDistribution.h"
+
+// exp(mu + shape * Z) for standard normal Z, with mu chosen for mean
+// 1 / intensity; shape is the standard deviation of the logarithm
+class LognormalDistribution final : public RandomDistribution {
+ public:
+  LognormalDistribution(double intensity, double shape,
+                        std::unique_ptr<IRandomEngine> engine);
+  ~LognormalDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+  void reseed(const StreamId& stream) override;
+
+ private:
+  void update();
+
+  double mean_;
+  double sigma_;
+  double mu_;
+  BitBlock bits_;
+};
+
+#endif  // SIM_UTILS_LOGNORMAL_DISTRIBUTION_H_
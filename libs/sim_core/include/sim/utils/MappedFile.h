@@ -0,0 +1,37 @@
+#ifndef SIM_UTILS_MAPPED_FILE_H_
+#define SIM_UTILS_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are read in on first
+// touch and stay in the OS page cache rather than in the process, so
+// files far larger than RAM can be streamed through.
+class MappedFile {
+ public:
+  // Throws std::runtime_error if the file cannot be opened or mapped
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const std::byte* get_data() const { return data_; }
+  size_t get_size() const { return size_; }
+
+  // Hints that the file is read front to back: the OS reads ahead
+  // aggressively and may drop pages soon after they are passed
+  void advise_sequential() const;
+  // Drops the whole pages within [offset, offset + length) from the
+  // process; touching them again reads them back in
+  void release(size_t offset, size_t length) const;
+
+ private:
+  const std::byte* data_;
+  size_t size_;
+#ifdef _WIN32
+  void* file_;
+  void* mapping_;
+#endif
+};
+
+#endif  // SIM_UTILS_MAPPED_FILE_H_
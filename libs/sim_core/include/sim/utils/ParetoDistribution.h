@@ -0,0 +1,28 @@
+#ifndef SIM_UTILS_PARETO_DISTRIBUTION_H_
+#define SIM_UTILS_PARETO_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/RandomDistribution.h"
+
+// Pareto (type I) with tail index shape > 1 and mean 1 / intensity, by
+// inversion: x_m * u^(-1 / shape), the logarithm taken by VectorMath
+class ParetoDistribution final : public RandomDistribution {
+ public:
+  ParetoDistribution(double intensity, double shape,
+                     std::unique_ptr<IRandomEngine> engine);
+  ~ParetoDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+
+ private:
+  void update();
+
+  double mean_;
+  double alpha_;
+  double minimum_;
+};
+
+#endif  // SIM_UTILS_PARETO_DISTRIBUTION_H_
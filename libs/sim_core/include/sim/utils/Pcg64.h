@@ -0,0 +1,76 @@
+#ifndef SIM_UTILS_PCG_64_H_
+#define SIM_UTILS_PCG_64_H_
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#include "sim/utils/SplitMix64.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+// O'Neill's PCG64 (XSL RR 128/64): a 128-bit LCG whose high and low halves
+// are xor-folded and rotated. 16 bytes of state plus the fixed increment.
+class Pcg64 {
+ public:
+  using result_type = uint64_t;
+
+  explicit Pcg64(uint64_t seed = 0) { this->seed(seed); }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  void seed(uint64_t seed) {
+    SplitMix64 expand(seed);
+    high_ = expand();
+    low_ = expand();
+    step();
+  }
+
+  result_type operator()() {
+    step();
+    return std::rotr(high_ ^ low_, static_cast<int>(high_ >> 58));
+  }
+
+ private:
+  static constexpr uint64_t MULTIPLIER_HIGH = 0x2360ed051fc65da4ull;
+  static constexpr uint64_t MULTIPLIER_LOW = 0x4385df649fccf645ull;
+  static constexpr uint64_t INCREMENT_HIGH = 0x5851f42d4c957f2dull;
+  static constexpr uint64_t INCREMENT_LOW = 0x14057b7ef767814full;
+
+  // High 64 bits of a * b
+  static uint64_t mul_high(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    return static_cast<uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#else
+    uint64_t a_lo = a & 0xffffffffull, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffffull, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffull) + lo_hi;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+  }
+
+  // state = state * MULTIPLIER + INCREMENT mod 2^128
+  void step() {
+    uint64_t high = high_ * MULTIPLIER_LOW + low_ * MULTIPLIER_HIGH +
+                    mul_high(low_, MULTIPLIER_LOW);
+    uint64_t low = low_ * MULTIPLIER_LOW;
+    low_ = low + INCREMENT_LOW;
+    high_ = high + INCREMENT_HIGH + (low_ < low ? 1 : 0);
+  }
+
+  uint64_t high_;
+  uint64_t low_;
+};
+
+#endif  // SIM_UTILS_PCG_64_H_
@@ -0,0 +1,105 @@
+#ifndef SIM_UTILS_PHILOX_4X32_H_
+#define SIM_UTILS_PHILOX_4X32_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "sim/utils/StreamId.h"
+
+// Salmon et al.'s Philox4x32-10 counter-based generator: output block n of
+// a stream is a 10-round keyed bijection of the counter (n, id, kind)
+// under the key (seed, replication). Distinct streams therefore never
+// share a block, and any position of any stream is computed directly.
+class Philox4x32 {
+ public:
+  using result_type = uint64_t;
+  using Block = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  explicit Philox4x32(const StreamId& stream = {}) { seed(stream); }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  static Block encrypt(Block counter, Key key) {
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        key[0] += 0x9e3779b9u;
+        key[1] += 0xbb67ae85u;
+      }
+      uint64_t product0 = uint64_t{0xd2511f53u} * counter[0];
+      uint64_t product1 = uint64_t{0xcd9e8d57u} * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                 static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                 static_cast<uint32_t>(product0)};
+    }
+    return counter;
+  }
+
+  // A 64-bit seed for a conventional engine, unique to the stream up to
+  // the 64-bit truncation. Taken from the stream's last block, which the
+  // generator itself never reaches.
+  static uint64_t derive_seed(const StreamId& stream) {
+    Block block = encrypt({0xffffffffu, 0xffffffffu, stream.id,
+                           static_cast<uint32_t>(stream.kind)},
+                          {stream.seed, stream.replication});
+    return (uint64_t{block[1]} << 32) | block[0];
+  }
+
+  void seed(const StreamId& stream) {
+    key_ = {stream.seed, stream.replication};
+    counter_ = {0, 0, stream.id, static_cast<uint32_t>(stream.kind)};
+    index_ = OUTPUTS_PER_BLOCK;
+  }
+
+  result_type operator()() {
+    if (index_ == OUTPUTS_PER_BLOCK) {
+      output_ = encrypt(counter_, key_);
+      next_block();
+      index_ = 0;
+    }
+    size_t word = 2 * index_++;
+    return (uint64_t{output_[word + 1]} << 32) | output_[word];
+  }
+
+  // Skips count outputs in O(1)
+  void discard(unsigned long long count) {
+    uint64_t position = block_position() * OUTPUTS_PER_BLOCK + count;
+    if (index_ != OUTPUTS_PER_BLOCK) {
+      // The current block has already been counted past
+      position += index_ - OUTPUTS_PER_BLOCK;
+    }
+    counter_[0] = static_cast<uint32_t>(position / OUTPUTS_PER_BLOCK);
+    counter_[1] = static_cast<uint32_t>(position / OUTPUTS_PER_BLOCK >> 32);
+    index_ = OUTPUTS_PER_BLOCK;
+    size_t skip = static_cast<size_t>(position % OUTPUTS_PER_BLOCK);
+    for (size_t i = 0; i < skip; ++i) {
+      (*this)();
+    }
+  }
+
+ private:
+  static constexpr size_t OUTPUTS_PER_BLOCK = 2;
+
+  uint64_t block_position() const {
+    return (uint64_t{counter_[1]} << 32) | counter_[0];
+  }
+
+  void next_block() {
+    if (++counter_[0] == 0) {
+      ++counter_[1];
+    }
+  }
+
+  Key key_;
+  Block counter_;
+  Block output_;
+  size_t index_;
+};
+
+#endif  // SIM_UTILS_PHILOX_4X32_H_
@@ -0,0 +1,24 @@
+#ifndef SIM_UTILS_RANDOM_DISTRIBUTION_H_
+#define SIM_UTILS_RANDOM_DISTRIBUTION_H_
+
+#include <memory>
+#include <utility>
+
+#include "sim/utils/IDistribution.h"
+#include "sim/utils/IRandomEngine.h"
+
+// Base of the distributions that draw from a random engine
+class RandomDistribution : public IDistribution {
+ public:
+  explicit RandomDistribution(std::unique_ptr<IRandomEngine> engine)
+      : engine_(std::move(engine)) {}
+
+  void reseed(const StreamId& stream) override { engine_->seed(stream); }
+
+  const IRandomEngine& get_engine() const { return *engine_; }
+
+ protected:
+  std::unique_ptr<IRandomEngine> engine_;
+};
+
+#endif  // SIM_UTILS_RANDOM_DISTRIBUTION_H_
@@ -0,0 +1,80 @@
+#ifndef SIM_UTILS_RANDOM_ENGINE_H_
+#define SIM_UTILS_RANDOM_ENGINE_H_
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+
+#include "sim/utils/IRandomEngine.h"
+#include "sim/utils/Philox4x32.h"
+
+// Adapts a uniform random bit generator (std::mt19937, Xoshiro256PlusPlus,
+// ...) to IRandomEngine. The virtual call is paid once per fill_uniform()
+// block, the generator itself is inlined. Philox4x32 takes the stream as
+// is; the other engines are seeded with Philox4x32::derive_seed(), through
+// std::seed_seq for those taking a 32-bit seed, so that no bits are lost.
+template <class Engine>
+class RandomEngine final : public IRandomEngine {
+ public:
+  explicit RandomEngine(const StreamId& stream)
+      : engine_(make_engine(stream)) {}
+
+  double next_uniform() override { return draw(); }
+
+  void fill_uniform(std::span<double> values) override {
+    for (double& value : values) {
+      value = draw();
+    }
+  }
+
+  uint64_t next_bits() override { return bits(); }
+
+  void fill_bits(std::span<uint64_t> values) override {
+    for (uint64_t& value : values) {
+      value = bits();
+    }
+  }
+
+  void seed(const StreamId& stream) override { engine_ = make_engine(stream); }
+
+ private:
+  static Engine make_engine(const StreamId& stream) {
+    if constexpr (std::is_same_v<Engine, Philox4x32>) {
+      return Engine(stream);
+    } else if constexpr (sizeof(typename Engine::result_type) <
+                         sizeof(uint64_t)) {
+      uint64_t seed = Philox4x32::derive_seed(stream);
+      std::seed_seq sequence{static_cast<uint32_t>(seed),
+                             static_cast<uint32_t>(seed >> 32)};
+      return Engine(sequence);
+    } else {
+      return Engine(static_cast<typename Engine::result_type>(
+          Philox4x32::derive_seed(stream)));
+    }
+  }
+
+  double draw() {
+    if constexpr (Engine::max() <= 0xffffffffull) {
+      // 27 + 26 bits from two 32-bit draws
+      uint64_t high = static_cast<uint64_t>(engine_()) >> 5;
+      uint64_t low = static_cast<uint64_t>(engine_()) >> 6;
+      return static_cast<double>(((high << 26) | low) + 1) * 0x1.0p-53;
+    } else {
+      return static_cast<double>((engine_() >> 11) + 1) * 0x1.0p-53;
+    }
+  }
+
+  uint64_t bits() {
+    if constexpr (Engine::max() <= 0xffffffffull) {
+      uint64_t high = static_cast<uint64_t>(engine_());
+      return (high << 32) | static_cast<uint64_t>(engine_());
+    } else {
+      return engine_();
+    }
+  }
+
+  Engine engine_;
+};
+
+#endif  // SIM_UTILS_RANDOM_ENGINE_H_
@@ -0,0 +1,33 @@
+#ifndef SIM_UTILS_SPLIT_MIX_64_H_
+#define SIM_UTILS_SPLIT_MIX_64_H_
+
+#include <cstdint>
+#include <limits>
+
+// Steele, Lea and Flood's SplitMix64: a Weyl sequence through a 64-bit
+// finalizer. 8 bytes of state; also expands seeds for the larger engines.
+class SplitMix64 {
+ public:
+  using result_type = uint64_t;
+
+  explicit SplitMix64(uint64_t seed = 0) : state_(seed) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  void seed(uint64_t seed) { state_ = seed; }
+
+  result_type operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+ private:
+  uint64_t state_;
+};
+
+#endif  // SIM_UTILS_SPLIT_MIX_64_H_
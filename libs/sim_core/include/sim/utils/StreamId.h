@@ -0,0 +1,22 @@
+#ifndef SIM_UTILS_STREAM_ID_H_
+#define SIM_UTILS_STREAM_ID_H_
+
+#include <cstdint>
+
+// Owner of a random stream
+enum class StreamKind : uint32_t {
+  Source,
+  Device,
+  DeviceSelection
+};
+
+// Names one random stream: the counter-based generator is keyed on
+// (seed, replication), and (kind, id) select the stream under that key
+struct StreamId {
+  uint32_t seed = 0;
+  uint32_t replication = 0;
+  StreamKind kind = StreamKind::Source;
+  uint32_t id = 0;
+};
+
+#endif  // SIM_UTILS_STREAM_ID_H_
@@ -0,0 +1,82 @@
+#ifndef SIM_UTILS_TRACE_DISTRIBUTION_H_
+#define SIM_UTILS_TRACE_DISTRIBUTION_H_
+
+#include <cstddef>
+#include <string>
+
+#include "sim/utils/IDistribution.h"
+#include "sim/utils/MappedFile.h"
+
+// Column of a trace file a TraceDistribution replays
+enum class TraceColumn {
+  Timestamps,   // as the intervals between them, for sources
+  ServiceTimes  // as they are, for devices
+};
+
+// Replays a recorded trace straight out of a memory-mapped file. Past its
+// end the values are infinite, which stops a source, unless loop is set and
+// the trace starts over. The file holds "SIMTRAC1", the uint64 record
+// count and the uint64 column count (1 or 2), then per record the arrival
+// timestamp and optionally the service time, all doubles in host byte
+// order.
+//
+// Timestamps must be non-decreasing from 0; the first interval runs from
+// 0, and a source adding the intervals up lands on the recorded timestamps
+// exactly. A decrease replays as a zero interval. The parameter is the
+// playback rate: values are divided by it.
+//
+// A distribution may replay only the part-th of parts equal slices of the
+// records, so that entities sharing a trace never replay the same records.
+// Looping starts the slice over, and a slice of timestamps runs from the
+// timestamp before it.
+class TraceDistribution final : public IDistribution {
+ public:
+  // Throws std::runtime_error if the file cannot be mapped and
+  // std::invalid_argument if it is not a trace with the column or has
+  // fewer records than parts
+  TraceDistribution(double rate, const std::string& path, TraceColumn column,
+                    bool loop, size_t part = 0, size_t parts = 1);
+  ~TraceDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  // Restarts at the first record; the stream is not used
+  void reseed(const StreamId& stream) override;
+
+  const std::string& get_path() const { return path_; }
+  TraceColumn get_column() const { return column_; }
+  bool is_looping() const { return loop_; }
+  size_t get_part() const { return part_; }
+  size_t get_parts() const { return parts_; }
+  // Records in the slice replayed
+  size_t get_size() const { return records_; }
+
+ private:
+  // Consumed pages are handed back in chunks of this many bytes, so a
+  // replay holds about one chunk of the file however long it is
+  static constexpr size_t RELEASE_CHUNK = size_t{32} << 20;
+
+  void restart();
+  void release_consumed();
+
+  MappedFile file_;
+  std::string path_;
+  TraceColumn column_;
+  bool loop_;
+  size_t part_;
+  size_t parts_;
+  // The column's value in the slice's first record, the doubles per
+  // record, and where the slice starts in the file
+  const double* values_;
+  size_t stride_;
+  size_t records_;
+  size_t first_byte_;
+  double first_previous_timestamp_;
+
+  size_t position_;
+  double previous_timestamp_;
+  double scale_;
+  size_t released_bytes_;
+};
+
+#endif  // SIM_UTILS_TRACE_DISTRIBUTION_H_
@@ -0,0 +1,34 @@
+#ifndef SIM_UTILS_TRUNCATED_NORMAL_DISTRIBUTION_H_
+#define SIM_UTILS_TRUNCATED_NORMAL_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/RandomDistribution.h"
+
+// Normal with standard deviation shape * location, conditioned on being
+// positive; the location is chosen for mean 1 / intensity. Rejection
+// costs little for shape up to about 1.
+class TruncatedNormalDistribution final : public RandomDistribution {
+ public:
+  TruncatedNormalDistribution(double intensity, double shape,
+                              std::unique_ptr<IRandomEngine> engine);
+  ~TruncatedNormalDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+  void reseed(const StreamId& stream) override;
+
+ private:
+  void update();
+  double sample();
+
+  double mean_;
+  double cv_;
+  double location_;
+  double scale_;
+  BitBlock bits_;
+};
+
+#endif  // SIM_UTILS_TRUNCATED_NORMAL_DISTRIBUTION_H_
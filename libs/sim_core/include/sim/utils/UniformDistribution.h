@@ -0,0 +1,29 @@
+#ifndef SIM_UTILS_UNIFORM_DISTRIBUTION_H_
+#define SIM_UTILS_UNIFORM_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/RandomDistribution.h"
+
+// Uniform on (mean * (1 - shape), mean * (1 + shape)] for mean
+// 1 / intensity and 0 <= shape <= 1
+class UniformDistribution final : public RandomDistribution {
+ public:
+  UniformDistribution(double intensity, double shape,
+                      std::unique_ptr<IRandomEngine> engine);
+  ~UniformDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+
+ private:
+  void update();
+
+  double mean_;
+  double half_width_;
+  double low_;
+  double width_;
+};
+
+#endif  // SIM_UTILS_UNIFORM_DISTRIBUTION_H_
@@ -0,0 +1,36 @@
+#ifndef SIM_UTILS_VARIATE_BLOCK_H_
+#define SIM_UTILS_VARIATE_BLOCK_H_
+
+#include <array>
+#include <cstddef>
+
+#include "sim/utils/IDistribution.h"
+
+// Variates prefetched from a distribution with one fill() call per block.
+// They come out in the order single generate() calls would return them, so
+// the stream does not depend on SIZE.
+class VariateBlock {
+ public:
+  static constexpr size_t SIZE = 16;
+
+  // Distribution may name the concrete (final) type of distribution, which
+  // turns the refill into a direct call
+  template <class Distribution = IDistribution>
+  double next(IDistribution& distribution) {
+    if (position_ == SIZE) {
+      static_cast<Distribution&>(distribution).fill(values_);
+      position_ = 0;
+    }
+    return values_[position_++];
+  }
+
+  // Drops the variates not consumed yet, e.g. after the distribution has
+  // been reseeded or replaced
+  void clear() { position_ = SIZE; }
+
+ private:
+  std::array<double, SIZE> values_;
+  size_t position_ = SIZE;
+};
+
+#endif  // SIM_UTILS_VARIATE_BLOCK_H_
@@ -0,0 +1,29 @@
+#ifndef SIM_UTILS_VECTOR_MATH_H_
+#define SIM_UTILS_VECTOR_MATH_H_
+
+#include <span>
+
+// Instruction sets the kernels below can run on
+enum class SimdLevel {
+  Scalar,
+  Avx2,
+  Avx512
+};
+
+// Elementwise kernels used by the samplers. Every SIMD level performs the
+// same IEEE operations in the same order as the scalar code (no fused
+// multiply-add), so results are bit-identical whichever level runs and
+// however the input is split into calls.
+class VectorMath {
+ public:
+  // Highest level supported by both the build and the running CPU
+  static SimdLevel get_simd_level();
+
+  // values[i] = log(values[i]) * scale, for positive normal values. The
+  // logarithm is fdlibm's algorithm, within 1 ulp of the exact result.
+  static void log_scaled(std::span<double> values, double scale);
+  static void log_scaled(std::span<double> values, double scale,
+                         SimdLevel level);
+};
+
+#endif  // SIM_UTILS_VECTOR_MATH_H_
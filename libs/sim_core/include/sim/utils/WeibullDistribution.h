@@ -0,0 +1,28 @@
+#ifndef SIM_UTILS_WEIBULL_DISTRIBUTION_H_
+#define SIM_UTILS_WEIBULL_DISTRIBUTION_H_
+
+#include <memory>
+
+#include "sim/utils/RandomDistribution.h"
+
+// Weibull with shape k > 0 and mean 1 / intensity, by inversion:
+// scale * (-log u)^(1 / k), the logarithm taken by VectorMath
+class WeibullDistribution final : public RandomDistribution {
+ public:
+  WeibullDistribution(double intensity, double shape,
+                      std::unique_ptr<IRandomEngine> engine);
+  ~WeibullDistribution() override = default;
+  double generate() override;
+  void fill(std::span<double> values) override;
+  void set_parameter(double param) override;
+  void set_shape(double shape) override;
+
+ private:
+  void update();
+
+  double mean_;
+  double k_;
+  double scale_;
+};
+
+#endif  // SIM_UTILS_WEIBULL_DISTRIBUTION_H_
@@ -0,0 +1,47 @@
+#ifndef SIM_UTILS_XOSHIRO_256_PLUS_PLUS_H_
+#define SIM_UTILS_XOSHIRO_256_PLUS_PLUS_H_
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#include "sim/utils/SplitMix64.h"
+
+// Blackman and Vigna's xoshiro256++, 32 bytes of state, period 2^256 - 1
+class Xoshiro256PlusPlus {
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256PlusPlus(uint64_t seed = 0) { this->seed(seed); }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  // The state is expanded with SplitMix64, as the authors recommend, so it
+  // is never all zero
+  void seed(uint64_t seed) {
+    SplitMix64 expand(seed);
+    for (auto& word : state_) {
+      word = expand();
+    }
+  }
+
+  result_type operator()() {
+    uint64_t result = std::rotl(state_[0] + state_[3], 23) + state_[0];
+    uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = std::rotl(state_[3], 45);
+    return result;
+  }
+
+ private:
+  uint64_t state_[4];
+};
+
+#endif  // SIM_UTILS_XOSHIRO_256_PLUS_PLUS_H_
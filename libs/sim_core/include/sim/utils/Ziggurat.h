@@ -0,0 +1,26 @@
+#ifndef SIM_UTILS_ZIGGURAT_H_
+#define SIM_UTILS_ZIGGURAT_H_
+
+#include <span>
+
+#include "sim/utils/BitBlock.h"
+#include "sim/utils/IRandomEngine.h"
+
+// Marsaglia and Tsang's ziggurat method with 256 layers. A variate costs
+// one 64-bit word, a table lookup and a multiply about 99% of the time;
+// the rest falls back to an exact rejection or tail step drawing further
+// words from the same block.
+class Ziggurat {
+ public:
+  // Standard normal variates
+  static double normal(BitBlock& bits, IRandomEngine& engine);
+  static void fill_normal(std::span<double> values, BitBlock& bits,
+                          IRandomEngine& engine);
+
+  // Exponential variates with mean 1
+  static double exponential(BitBlock& bits, IRandomEngine& engine);
+  static void fill_exponential(std::span<double> values, BitBlock& bits,
+                               IRandomEngine& engine);
+};
+
+#endif  // SIM_UTILS_ZIGGURAT_H_
@@ -1,48 +1,65 @@
 #include "sim/device/Device.h"
 
-#include "sim/model/Request.h"
+#include <stdexcept>
+#include <string>
 
 Device::Device(size_t id, std::unique_ptr<IDistribution> distribution)
     : id_(id),
       busy_(false),
-      current_request_(nullptr),
+      current_request_(NO_REQUEST),
       service_distribution_(std::move(distribution)),
-      next_service_end_time_(NO_EVENT_TIME) {}
+      next_service_end_time_(NO_EVENT_TIME),
+      busy_time_(0.0) {}
 
 bool Device::is_free() const { return !busy_; }
 
-void Device::start_service(std::shared_ptr<Request> request, double now) {
+void Device::start_service(RequestHandle request) {
   busy_ = true;
-  request->set_service_start_time(now);
   current_request_ = request;
 }
 
-std::shared_ptr<Request> Device::finish_service() {
+RequestHandle Device::finish_service() {
   if (busy_) {
     busy_ = false;
-    std::shared_ptr<Request> finished_request = current_request_;
-    current_request_ = nullptr;
+    RequestHandle finished_request = current_request_;
+    current_request_ = NO_REQUEST;
     return finished_request;
   }
-  return nullptr;
+  return NO_REQUEST;
 }
 
 size_t Device::get_id() const { return id_; }
 
-std::shared_ptr<Request> Device::get_current_request() const {
-  return current_request_;
+void Device::throw_exhausted() const {
+  throw std::runtime_error("Device " + std::to_string(id_) +
+                           " ran out of service times");
 }
 
-double Device::schedule_next_service_end(double current_time) {
-  double service_time = service_distribution_->generate();
-  next_service_end_time_ = current_time + service_time;
-  return next_service_end_time_;
+RequestHandle Device::get_current_request() const {
+  return current_request_;
 }
 
 double Device::get_next_service_end_time() const {
   return next_service_end_time_;
 }
 
+double Device::get_busy_time() const { return busy_time_; }
+
 void Device::clear_next_service_end_time() {
   next_service_end_time_ = NO_EVENT_TIME;
 }
+
+IDistribution& Device::get_distribution() { return *service_distribution_; }
+
+void Device::set_distribution(std::unique_ptr<IDistribution> distribution) {
+  service_distribution_ = std::move(distribution);
+  variates_.clear();
+}
+
+void Device::reset() {
+  busy_time_ = 0.0;
+  busy_ = false;
+  current_request_ = NO_REQUEST;
+  next_service_end_time_ = NO_EVENT_TIME;
+  variates_.clear();
+}
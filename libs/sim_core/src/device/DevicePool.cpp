@@ -11,10 +11,7 @@ DevicePool::DevicePool(size_t num_devices,
     auto distribution = std::move(distributions[i]);
     devices_.emplace_back(std::make_unique<Device>(i, std::move(distribution)));
   }
-}
-
-Device* DevicePool::find_free_device() {
-  return strategy_->find_free_device(devices_);
+  rebuild_free_devices();
 }
 
 Device& DevicePool::get_device(size_t id) {
@@ -65,8 +62,55 @@ size_t DevicePool::size() const {
   return devices_.size();
 }
 
+void DevicePool::set_strategy(
+    std::unique_ptr<IDeviceSelectionStrategy> strategy) {
+  strategy_ = std::move(strategy);
+}
+
+const IDeviceSelectionStrategy& DevicePool::get_strategy() const {
+  return *strategy_;
+}
+
 void DevicePool::reset_strategy() {
   if (strategy_) {
     strategy_->reset();
   }
 }
+
+void DevicePool::add_device(std::unique_ptr<Device> device) {
+  if (!device || device->get_id() != devices_.size()) {
+    throw std::invalid_argument("Device ID must equal the pool size");
+  }
+  devices_.push_back(std::move(device));
+  rebuild_free_devices();
+}
+
+void DevicePool::truncate(size_t count) {
+  if (count < devices_.size()) {
+    devices_.resize(count);
+    rebuild_free_devices();
+  }
+}
+
+void DevicePool::reset() {
+  for (auto& device : devices_) {
+    if (device) {
+      device->reset();
+    }
+  }
+  rebuild_free_devices();
+  reset_strategy();
+}
+
+const IndexBitmap& DevicePool::get_free_devices() const {
+  return free_devices_;
+}
+
+void DevicePool::rebuild_free_devices() {
+  free_devices_.assign(devices_.size(), false);
+  for (size_t id = 0; id < devices_.size(); ++id) {
+    if (devices_[id] && devices_[id]->is_free()) {
+      free_devices_.set(id);
+    }
+  }
+}
@@ -0,0 +1,43 @@
+#include "sim/device/FastestFreeStrategy.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "sim/device/Device.h"
+
+FastestFreeStrategy::FastestFreeStrategy(
+    const std::vector<double>& mean_service_times)
+    : device_at_rank_(mean_service_times.size()),
+      rank_of_device_(mean_service_times.size()) {
+  std::iota(device_at_rank_.begin(), device_at_rank_.end(), 0);
+  std::stable_sort(device_at_rank_.begin(), device_at_rank_.end(),
+                   [&](size_t lhs, size_t rhs) {
+                     return mean_service_times[lhs] < mean_service_times[rhs];
+                   });
+  for (size_t rank = 0; rank < device_at_rank_.size(); ++rank) {
+    rank_of_device_[device_at_rank_[rank]] = rank;
+  }
+  reset();
+}
+
+Device* FastestFreeStrategy::find_free_device(
+    const std::vector<std::unique_ptr<Device>>& devices,
+    const IndexBitmap& /*free_devices*/) {
+  size_t rank = free_ranks_.find_next(0);
+  if (rank == IndexBitmap::NPOS) {
+    return nullptr;
+  }
+  return devices[device_at_rank_[rank]].get();
+}
+
+void FastestFreeStrategy::on_device_busy(const Device& device) {
+  free_ranks_.reset(rank_of_device_[device.get_id()]);
+}
+
+void FastestFreeStrategy::on_device_free(const Device& device) {
+  free_ranks_.set(rank_of_device_[device.get_id()]);
+}
+
+void FastestFreeStrategy::reset() {
+  free_ranks_.assign(device_at_rank_.size(), true);
+}
@@ -0,0 +1,14 @@
+#include "sim/device/FixedPriorityStrategy.h"
+
+#include "sim/device/Device.h"
+#include "sim/utils/IndexBitmap.h"
+
+Device* FixedPriorityStrategy::find_free_device(
+    const std::vector<std::unique_ptr<Device>>& devices,
+    const IndexBitmap& free_devices) {
+  size_t index = free_devices.find_next(0);
+  if (index == IndexBitmap::NPOS) {
+    return nullptr;
+  }
+  return devices[index].get();
+}
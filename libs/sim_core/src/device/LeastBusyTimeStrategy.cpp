@@ -0,0 +1,98 @@
+#include "sim/device/LeastBusyTimeStrategy.h"
+
+#include "sim/device/Device.h"
+
+LeastBusyTimeStrategy::LeastBusyTimeStrategy(size_t num_devices)
+    : position_(num_devices), busy_time_(num_devices) {
+  heap_.reserve(num_devices);
+  reset();
+}
+
+Device* LeastBusyTimeStrategy::find_free_device(
+    const std::vector<std::unique_ptr<Device>>& devices,
+    const IndexBitmap& /*free_devices*/) {
+  if (heap_.empty()) {
+    return nullptr;
+  }
+  return devices[heap_.front()].get();
+}
+
+void LeastBusyTimeStrategy::on_device_busy(const Device& device) {
+  size_t position = position_[device.get_id()];
+  if (position == NOT_IN_HEAP) {
+    return;
+  }
+  position_[device.get_id()] = NOT_IN_HEAP;
+  size_t last = heap_.back();
+  heap_.pop_back();
+  if (position < heap_.size()) {
+    place(position, last);
+    sift_up(position);
+    sift_down(position_[last]);
+  }
+}
+
+void LeastBusyTimeStrategy::on_device_free(const Device& device) {
+  size_t id = device.get_id();
+  if (position_[id] != NOT_IN_HEAP) {
+    return;
+  }
+  busy_time_[id] = device.get_busy_time();
+  heap_.push_back(id);
+  position_[id] = heap_.size() - 1;
+  sift_up(heap_.size() - 1);
+}
+
+void LeastBusyTimeStrategy::reset() {
+  // Every device free with no busy time: ids in order already form a heap
+  heap_.clear();
+  for (size_t id = 0; id < position_.size(); ++id) {
+    heap_.push_back(id);
+    position_[id] = id;
+    busy_time_[id] = 0.0;
+  }
+}
+
+bool LeastBusyTimeStrategy::less(size_t lhs, size_t rhs) const {
+  if (busy_time_[lhs] != busy_time_[rhs]) {
+    return busy_time_[lhs] < busy_time_[rhs];
+  }
+  return lhs < rhs;
+}
+
+void LeastBusyTimeStrategy::place(size_t position, size_t id) {
+  heap_[position] = id;
+  position_[id] = position;
+}
+
+void LeastBusyTimeStrategy::sift_up(size_t position) {
+  size_t id = heap_[position];
+  while (position > 0) {
+    size_t parent = (position - 1) / 2;
+    if (!less(id, heap_[parent])) {
+      break;
+    }
+    place(position, heap_[parent]);
+    position = parent;
+  }
+  place(position, id);
+}
+
+void LeastBusyTimeStrategy::sift_down(size_t position) {
+  size_t id = heap_[position];
+  while (true) {
+    size_t child = 2 * position + 1;
+    if (child >= heap_.size()) {
+      break;
+    }
+    if (child + 1 < heap_.size() && less(heap_[child + 1], heap_[child])) {
+      ++child;
+    }
+    if (!less(heap_[child], id)) {
+      break;
+    }
+    place(position, heap_[child]);
+    position = child;
+  }
+  place(position, id);
+}
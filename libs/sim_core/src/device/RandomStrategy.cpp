@@ -0,0 +1,67 @@
+#include "sim/device/RandomStrategy.h"
+
+#include "sim/device/Device.h"
+#include "sim/utils/Philox4x32.h"
+
+RandomStrategy::RandomStrategy(size_t num_devices, const StreamId& stream)
+    : position_(num_devices),
+      seed_(Philox4x32::derive_seed(stream)),
+      rng_(seed_) {
+  free_ids_.reserve(num_devices);
+  reset();
+}
+
+Device* RandomStrategy::find_free_device(
+    const std::vector<std::unique_ptr<Device>>& devices,
+    const IndexBitmap& /*free_devices*/) {
+  if (free_ids_.empty()) {
+    return nullptr;
+  }
+  return devices[free_ids_[pick(free_ids_.size())]].get();
+}
+
+// Lemire's multiply-shift on the top 32 bits of a word, rejecting the low
+// products that would make some indices likelier than others
+size_t RandomStrategy::pick(size_t count) {
+  auto range = static_cast<uint32_t>(count);
+  uint64_t product = (rng_() >> 32) * range;
+  if (static_cast<uint32_t>(product) < range) {
+    uint32_t threshold = (0u - range) % range;
+    while (static_cast<uint32_t>(product) < threshold) {
+      product = (rng_() >> 32) * range;
+    }
+  }
+  return static_cast<size_t>(product >> 32);
+}
+
+void RandomStrategy::on_device_busy(const Device& device) {
+  size_t id = device.get_id();
+  size_t position = position_[id];
+  if (position == NOT_FREE) {
+    return;
+  }
+  // Swap with the last free id and drop it
+  size_t last = free_ids_.back();
+  free_ids_[position] = last;
+  position_[last] = position;
+  free_ids_.pop_back();
+  position_[id] = NOT_FREE;
+}
+
+void RandomStrategy::on_device_free(const Device& device) {
+  size_t id = device.get_id();
+  if (position_[id] != NOT_FREE) {
+    return;
+  }
+  position_[id] = free_ids_.size();
+  free_ids_.push_back(id);
+}
+
+void RandomStrategy::reset() {
+  free_ids_.clear();
+  for (size_t id = 0; id < position_.size(); ++id) {
+    free_ids_.push_back(id);
+    position_[id] = id;
+  }
+  rng_.seed(seed_);
+}
@@ -1,21 +1,20 @@
 #include "sim/device/RoundRobinStrategy.h"
 
 #include "sim/device/Device.h"
+#include "sim/utils/IndexBitmap.h"
 
 Device* RoundRobinStrategy::find_free_device(
-    const std::vector<std::unique_ptr<Device>>& devices) {
-  if (devices.empty()) {
-    return nullptr;
+    const std::vector<std::unique_ptr<Device>>& devices,
+    const IndexBitmap& free_devices) {
+  // First free device starting from next_index_, wrapping around
+  size_t index = free_devices.find_next(next_index_);
+  if (index == IndexBitmap::NPOS) {
+    index = free_devices.find_next(0);
   }
-
-  // Start search from next_index_
-  for (size_t offset = 0; offset < devices.size(); ++offset) {
-    size_t index = (next_index_ + offset) % devices.size();
-    if (devices[index] && devices[index]->is_free()) {
-      next_index_ = (index + 1) % devices.size();
-      return devices[index].get();
-    }
+  if (index == IndexBitmap::NPOS) {
+    return nullptr;
   }
 
-  return nullptr;
+  next_index_ = (index + 1) % devices.size();
+  return devices[index].get();
 }
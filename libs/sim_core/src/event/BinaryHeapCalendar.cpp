@@ -0,0 +1,46 @@
+#include "sim/event/BinaryHeapCalendar.h"
+
+#include <algorithm>
+
+void BinaryHeapCalendar::schedule(const Event& event) {
+  heap_.push_back(event);
+  std::push_heap(heap_.begin(), heap_.end());
+}
+
+void BinaryHeapCalendar::schedule_bulk(std::span<const Event> events) {
+  // Floyd's heapify is O(n + k); only worth it for large blocks
+  bool heapify = events.size() >= heap_.size() / 4;
+  size_t old_size = heap_.size();
+  heap_.insert(heap_.end(), events.begin(), events.end());
+  if (heapify) {
+    std::make_heap(heap_.begin(), heap_.end());
+  } else {
+    for (size_t i = old_size; i < heap_.size(); ++i) {
+      std::push_heap(heap_.begin(), heap_.begin() + (i + 1));
+    }
+  }
+}
+
+Event BinaryHeapCalendar::pop_next() {
+  std::pop_heap(heap_.begin(), heap_.end());
+  Event event = heap_.back();
+  heap_.pop_back();
+  return event;
+}
+
+void BinaryHeapCalendar::pop_batch(std::vector<Event>& batch) {
+  double time = heap_.front().get_time();
+  do {
+    std::pop_heap(heap_.begin(), heap_.end());
+    batch.push_back(heap_.back());
+    heap_.pop_back();
+  } while (!heap_.empty() && heap_.front().get_time() == time);
+}
+
+Event BinaryHeapCalendar::peek_next() const { return heap_.front(); }
+
+size_t BinaryHeapCalendar::get_size() const { return heap_.size(); }
+
+bool BinaryHeapCalendar::is_empty() const { return heap_.empty(); }
+
+void BinaryHeapCalendar::clear() { heap_.clear(); }
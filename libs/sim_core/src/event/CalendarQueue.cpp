@@ -0,0 +1,235 @@
+#include "sim/event/CalendarQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Keeps day numbers far away from uint64_t overflow for extreme time/width
+// ratios; such events simply share the last day and are found by the
+// direct search in locate_next().
+constexpr double MAX_DAY = 9.0e18;
+
+bool earlier_time(const Event& lhs, const Event& rhs) {
+  return lhs.get_time() < rhs.get_time();
+}
+
+// Firing order, the reverse of operator<
+bool fires_first(const Event& lhs, const Event& rhs) { return rhs < lhs; }
+
+}  // namespace
+
+CalendarQueue::CalendarQueue()
+    : buckets_(MIN_BUCKETS),
+      bucket_mask_(MIN_BUCKETS - 1),
+      width_(1.0),
+      size_(0),
+      current_day_(0) {}
+
+uint64_t CalendarQueue::day_of(double time) const {
+  double day = std::floor(time / width_);
+  if (!(day > 0.0)) {
+    return 0;
+  }
+  return static_cast<uint64_t>(std::min(day, MAX_DAY));
+}
+
+void CalendarQueue::insert(const Event& event) {
+  auto& bucket = buckets_[day_of(event.get_time()) & bucket_mask_];
+  auto& events = bucket.events;
+  if (bucket.empty() || event < events.back()) {
+    events.push_back(event);
+  } else if (bucket.head > 0 && bucket.front() < event) {
+    events[--bucket.head] = event;
+  } else {
+    // Sorted by firing order, so the comparison is reversed
+    auto first = events.begin() + static_cast<std::ptrdiff_t>(bucket.head);
+    events.insert(std::upper_bound(first, events.end(), event, fires_first),
+                  event);
+  }
+}
+
+void CalendarQueue::schedule(const Event& event) {
+  uint64_t day = day_of(event.get_time());
+  if (day < current_day_) {
+    current_day_ = day;
+  }
+  insert(event);
+  ++size_;
+
+  if (size_ > 2 * buckets_.size()) {
+    resize(2 * buckets_.size());
+  }
+}
+
+void CalendarQueue::schedule_bulk(std::span<const Event> events) {
+  // Size the ring for the final population once instead of doubling
+  // through every intermediate size
+  size_ += events.size();
+  size_t bucket_count = buckets_.size();
+  while (size_ > 2 * bucket_count) {
+    bucket_count *= 2;
+  }
+  if (bucket_count != buckets_.size()) {
+    resize(bucket_count, events);
+    return;
+  }
+  for (const auto& event : events) {
+    current_day_ = std::min(current_day_, day_of(event.get_time()));
+    insert(event);
+  }
+}
+
+Event CalendarQueue::pop_next() {
+  auto& bucket = buckets_[locate_next()];
+  Event event = bucket.front();
+  pop_front(bucket, 1);
+  return event;
+}
+
+void CalendarQueue::pop_batch(std::vector<Event>& batch) {
+  // Equal times share a day, so the batch is a run at the bucket's head
+  auto& bucket = buckets_[locate_next()];
+  auto first =
+      bucket.events.begin() + static_cast<std::ptrdiff_t>(bucket.head);
+  auto last = first + 1;
+  while (last != bucket.events.end() &&
+         last->get_time() == first->get_time()) {
+    ++last;
+  }
+  batch.insert(batch.end(), first, last);
+  pop_front(bucket, static_cast<size_t>(last - first));
+}
+
+void CalendarQueue::pop_front(Bucket& bucket, size_t count) {
+  bucket.head += count;
+  if (bucket.head == bucket.events.size()) {
+    bucket.clear();
+  } else if (bucket.head >= MIN_COMPACT &&
+             2 * bucket.head >= bucket.events.size()) {
+    bucket.events.erase(
+        bucket.events.begin(),
+        bucket.events.begin() + static_cast<std::ptrdiff_t>(bucket.head));
+    bucket.head = 0;
+  }
+  size_ -= count;
+
+  if (buckets_.size() > MIN_BUCKETS && size_ < buckets_.size() / 2) {
+    resize(buckets_.size() / 2);
+  }
+}
+
+Event CalendarQueue::peek_next() const {
+  return buckets_[locate_next()].front();
+}
+
+size_t CalendarQueue::locate_next() const {
+  // Walk one "year" of days starting at the cursor; the first bucket whose
+  // earliest event falls on the day being visited holds the global minimum.
+  for (size_t offset = 0; offset < buckets_.size(); ++offset) {
+    uint64_t day = current_day_ + offset;
+    const auto& bucket = buckets_[day & bucket_mask_];
+    if (!bucket.empty() && day_of(bucket.front().get_time()) == day) {
+      current_day_ = day;
+      return day & bucket_mask_;
+    }
+  }
+
+  // Sparse year: fall back to a direct search over all bucket heads
+  size_t best = buckets_.size();
+  for (size_t idx = 0; idx < buckets_.size(); ++idx) {
+    if (buckets_[idx].empty()) {
+      continue;
+    }
+    if (best == buckets_.size() ||
+        buckets_[best].front() < buckets_[idx].front()) {
+      best = idx;
+    }
+  }
+  current_day_ = day_of(buckets_[best].front().get_time());
+  return best;
+}
+
+void CalendarQueue::resize(size_t bucket_count,
+                           std::span<const Event> extra) {
+  // size_ already accounts for the extra events
+  std::vector<Event> events(extra.begin(), extra.end());
+  events.reserve(size_);
+  for (auto& bucket : buckets_) {
+    events.insert(events.end(),
+                  bucket.events.begin() +
+                      static_cast<std::ptrdiff_t>(bucket.head),
+                  bucket.events.end());
+    bucket.clear();
+  }
+
+  double width = estimate_width(events);
+  if (width > 0.0) {
+    width_ = width;
+  }
+
+  buckets_.resize(bucket_count);
+  bucket_mask_ = bucket_count - 1;
+  current_day_ = 0;
+  if (!events.empty()) {
+    // estimate_width() leaves the earliest event at the front
+    current_day_ = day_of(events.front().get_time());
+  }
+  // Sorting each bucket once keeps a resize of many equal times
+  // O(n log n) where inserting them one by one would be quadratic
+  for (const auto& event : events) {
+    buckets_[day_of(event.get_time()) & bucket_mask_].events.push_back(event);
+  }
+  for (auto& bucket : buckets_) {
+    std::sort(bucket.events.begin(), bucket.events.end(), fires_first);
+  }
+}
+
+double CalendarQueue::estimate_width(std::vector<Event>& events) const {
+  size_t sample = std::min(events.size(), WIDTH_SAMPLE_SIZE);
+  if (sample < 2) {
+    if (sample == 1) {
+      std::iter_swap(events.begin(),
+                     std::min_element(events.begin(), events.end(),
+                                      earlier_time));
+    }
+    return 0.0;
+  }
+
+  std::nth_element(events.begin(), events.begin() + (sample - 1),
+                   events.end(), earlier_time);
+  std::sort(events.begin(), events.begin() + sample, earlier_time);
+
+  double span = events[sample - 1].get_time() - events[0].get_time();
+  double average = span / static_cast<double>(sample - 1);
+
+  // Brown's refinement: ignore the outlying separations and use three
+  // times the average of the remaining ones
+  double sum = 0.0;
+  size_t count = 0;
+  for (size_t i = 1; i < sample; ++i) {
+    double gap = events[i].get_time() - events[i - 1].get_time();
+    if (gap <= 2.0 * average) {
+      sum += gap;
+      ++count;
+    }
+  }
+  if (count == 0 || sum <= 0.0) {
+    return 0.0;
+  }
+  return 3.0 * sum / static_cast<double>(count);
+}
+
+size_t CalendarQueue::get_size() const { return size_; }
+
+bool CalendarQueue::is_empty() const { return size_ == 0; }
+
+void CalendarQueue::clear() {
+  // The ring keeps its current bucket count; it shrinks again on demand
+  for (auto& bucket : buckets_) {
+    bucket.clear();
+  }
+  width_ = 1.0;
+  size_ = 0;
+  current_day_ = 0;
+}
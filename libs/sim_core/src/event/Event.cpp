@@ -1,41 +1,12 @@
 #include "sim/event/Event.h"
 
-#include "sim/device/Device.h"
-#include "sim/model/Request.h"
+#include <stdexcept>
 
-Event::Event(double time, EventType type, std::weak_ptr<Request> request,
-             Device* device, size_t source_id)
-    : time_(time),
-      type_(type),
-      request_(request),
-      device_(device),
-      source_id_(source_id) {}
-
-double Event::get_time() const { return time_; }
-
-EventType Event::get_type() const { return type_; }
-
-std::weak_ptr<Request> Event::get_request() const { return request_; }
-
-Device* Event::get_device() const { return device_; }
-
-size_t Event::get_request_id() const {
-  auto request = request_.lock();
-  return request ? request->get_id() : 0;
-}
-
-size_t Event::get_device_id() const { return device_ ? device_->get_id() : 0; }
-
-size_t Event::get_source_id() const { return source_id_; }
-
-bool operator<(const Event& lhs, const Event& rhs) {
-  if (lhs.get_time() != rhs.get_time()) return lhs.get_time() > rhs.get_time();
-  if (lhs.get_type() != rhs.get_type()) return lhs.get_type() > rhs.get_type();
-  // If times are equal, prefer events with lower source_id (for arrivals)
-  // or lower device_id (for service_end)
-  if (lhs.get_type() == EventType::arrival) {
-    return lhs.get_source_id() > rhs.get_source_id();
-  } else {
-    return lhs.get_device_id() > rhs.get_device_id();
+Event::Event(double time, EventType type, size_t entity_id)
+    : time_(time), sequence_(0) {
+  if (entity_id > MAX_ENTITY_ID) {
+    throw std::out_of_range("Event entity ID out of range");
   }
+  key_ = (static_cast<uint32_t>(type) << TYPE_SHIFT) |
+         static_cast<uint32_t>(entity_id);
 }
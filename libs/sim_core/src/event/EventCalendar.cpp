@@ -1,26 +1,113 @@
 #include "sim/event/EventCalendar.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "sim/event/BinaryHeapCalendar.h"
 #include "sim/event/Event.h"
 
-EventCalendar::EventCalendar() {}
+EventCalendar::EventCalendar()
+    : EventCalendar(std::make_unique<BinaryHeapCalendar>()) {}
+
+EventCalendar::EventCalendar(std::unique_ptr<IEventCalendar> backend)
+    : backend_(std::move(backend)), generation_(0) {
+  if (!backend_) {
+    backend_ = std::make_unique<BinaryHeapCalendar>();
+  }
+  reset();
+}
+
+void EventCalendar::schedule_bulk(std::span<Event> events) {
+  for (const auto& event : events) {
+    if (event.get_time() < last_popped_.get_time()) {
+      throw_past_event(event);
+    }
+  }
+  for (auto& event : events) {
+    event.set_sequence(next_sequence_++);
+  }
+  backend_->schedule_bulk(events);
+}
+
+void EventCalendar::cancel(const EventHandle& handle) {
+  const Event& event = handle.get_event();
+  // Anything pending fires after the last event popped
+  if (handle.generation_ != generation_ || !(event < last_popped_)) {
+    return;
+  }
+  if (backend_->remove(event)) {
+    return;
+  }
+  if (cancelled_.insert(event.get_sequence()).second) {
+    discard_cancelled_front();
+  }
+}
+
+EventHandle EventCalendar::reschedule(const EventHandle& handle,
+                                      double new_time) {
+  cancel(handle);
+  Event moved = handle.get_event();
+  moved.set_time(new_time);
+  return schedule(moved);
+}
 
-void EventCalendar::schedule(const Event& event) {
-  events_.push(event);
+void EventCalendar::discard_cancelled_front() {
+  while (!discarded_.empty() && !(discarded_.front() < last_popped_)) {
+    cancelled_.erase(discarded_.front().get_sequence());
+    std::pop_heap(discarded_.begin(), discarded_.end());
+    discarded_.pop_back();
+  }
+  while (cancelled_.size() > discarded_.size() && !backend_->is_empty()) {
+    Event front = backend_->peek_next();
+    if (!cancelled_.contains(front.get_sequence())) {
+      break;
+    }
+    backend_->pop_next();
+    discarded_.push_back(front);
+    std::push_heap(discarded_.begin(), discarded_.end());
+  }
 }
 
-Event EventCalendar::pop_next() {
-  Event event = events_.top();
-  events_.pop();
-  return event;
+void EventCalendar::drop_cancelled(std::vector<Event>& batch, size_t first) {
+  // The first event of a batch was the front, so it is never cancelled
+  auto kept = std::remove_if(
+      batch.begin() + static_cast<std::ptrdiff_t>(first), batch.end(),
+      [this](const Event& event) {
+        return cancelled_.erase(event.get_sequence()) != 0;
+      });
+  batch.erase(kept, batch.end());
+  discard_cancelled_front();
 }
 
-double EventCalendar::get_next_time() const {
-  if (events_.empty()) {
-    return NO_EVENT_TIME;
+void EventCalendar::clear() {
+  backend_->clear();
+  reset();
+}
+
+void EventCalendar::set_backend(std::unique_ptr<IEventCalendar> backend) {
+  backend_ = backend ? std::move(backend)
+                     : std::make_unique<BinaryHeapCalendar>();
+  reset();
+}
+
+void EventCalendar::reset() {
+  cancelled_.clear();
+  discarded_.clear();
+  next_sequence_ = 0;
+  // Skips 0, which default-constructed handles carry
+  if (++generation_ == 0) {
+    ++generation_;
   }
-  return events_.top().get_time();
+  last_popped_ = Event(-std::numeric_limits<double>::infinity(),
+                       EventType::arrival, 0);
 }
 
-size_t EventCalendar::get_size() const { return events_.size(); }
+void EventCalendar::throw_past_event(const Event& event) {
+  throw std::invalid_argument(
+      "Event at time " + std::to_string(event.get_time()) +
+      " is earlier than the last event popped");
+}
 
-bool EventCalendar::is_empty() const { return events_.empty(); }
+const IEventCalendar& EventCalendar::get_backend() const { return *backend_; }
@@ -0,0 +1,234 @@
+#include "sim/event/LadderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Firing order, the reverse of operator<
+bool fires_first(const Event& lhs, const Event& rhs) { return rhs < lhs; }
+
+}  // namespace
+
+LadderQueue::LadderQueue()
+    : top_start_(-INF),
+      top_min_(INF),
+      top_max_(-INF),
+      active_rungs_(0),
+      bottom_head_(0),
+      size_(0) {}
+
+size_t LadderQueue::bucket_index(const Rung& rung, double time) const {
+  double index = std::floor((time - rung.start) / rung.width);
+  if (!(index >= 0.0)) {
+    return 0;
+  }
+  double last = static_cast<double>(rung.buckets.size() - 1);
+  return static_cast<size_t>(std::min(index, last));
+}
+
+void LadderQueue::schedule(const Event& event) {
+  ++size_;
+  insert(event);
+  if (is_bottom_empty()) {
+    refill_bottom();
+  }
+}
+
+void LadderQueue::schedule_bulk(std::span<const Event> events) {
+  size_ += events.size();
+  for (const auto& event : events) {
+    insert(event);
+  }
+  if (is_bottom_empty()) {
+    refill_bottom();
+  }
+}
+
+void LadderQueue::insert(const Event& event) {
+  double time = event.get_time();
+  if (time >= top_start_) {
+    top_.push_back(event);
+    top_min_ = std::min(top_min_, time);
+    top_max_ = std::max(top_max_, time);
+  } else {
+    // A rung accepts the event if it falls into a bucket that has not been
+    // handed down yet; otherwise it precedes everything on the ladder.
+    bool placed = false;
+    for (size_t r = 0; r < active_rungs_ && !placed; ++r) {
+      Rung& rung = rungs_[r];
+      size_t index = bucket_index(rung, time);
+      if (index >= rung.current) {
+        rung.buckets[index].push_back(event);
+        ++rung.size;
+        placed = true;
+      }
+    }
+    if (!placed) {
+      insert_into_bottom(event);
+      // An overgrown Bottom becomes a new lowest rung, as in Tang's
+      // original, to keep its sorted insertion cheap
+      double min = bottom_[bottom_head_].get_time();
+      double max = bottom_.back().get_time();
+      if (bottom_.size() - bottom_head_ > BUCKET_THRESHOLD &&
+          active_rungs_ < MAX_RUNGS && max > min) {
+        scratch_.assign(
+            bottom_.begin() + static_cast<std::ptrdiff_t>(bottom_head_),
+            bottom_.end());
+        bottom_.clear();
+        bottom_head_ = 0;
+        spawn_rung(min, max);
+        refill_bottom();
+      }
+    }
+  }
+}
+
+void LadderQueue::insert_into_bottom(const Event& event) {
+  if (is_bottom_empty() || event < bottom_.back()) {
+    bottom_.push_back(event);
+  } else if (bottom_head_ > 0 && bottom_[bottom_head_] < event) {
+    bottom_[--bottom_head_] = event;
+  } else {
+    auto first = bottom_.begin() + static_cast<std::ptrdiff_t>(bottom_head_);
+    bottom_.insert(std::upper_bound(first, bottom_.end(), event, fires_first),
+                   event);
+  }
+}
+
+Event LadderQueue::pop_next() {
+  Event event = bottom_[bottom_head_++];
+  --size_;
+  if (is_bottom_empty()) {
+    bottom_.clear();
+    bottom_head_ = 0;
+    if (size_ > 0) {
+      refill_bottom();
+    }
+  } else if (bottom_head_ >= MIN_COMPACT &&
+             2 * bottom_head_ >= bottom_.size()) {
+    bottom_.erase(bottom_.begin(),
+                  bottom_.begin() + static_cast<std::ptrdiff_t>(bottom_head_));
+    bottom_head_ = 0;
+  }
+  return event;
+}
+
+void LadderQueue::pop_batch(std::vector<Event>& batch) {
+  double time = bottom_[bottom_head_].get_time();
+  do {
+    batch.push_back(pop_next());
+  } while (size_ > 0 && bottom_[bottom_head_].get_time() == time);
+}
+
+Event LadderQueue::peek_next() const { return bottom_[bottom_head_]; }
+
+void LadderQueue::refill_bottom() {
+  while (is_bottom_empty()) {
+    if (active_rungs_ == 0) {
+      if (top_.empty()) {
+        return;
+      }
+      scratch_.swap(top_);
+      top_.clear();
+      double min = top_min_;
+      double max = top_max_;
+      top_start_ = std::nextafter(max, INF);
+      top_min_ = INF;
+      top_max_ = -INF;
+
+      if (scratch_.size() <= BUCKET_THRESHOLD || !(max > min)) {
+        sort_into_bottom();
+      } else {
+        spawn_rung(min, max);
+      }
+      continue;
+    }
+
+    Rung& rung = rungs_[active_rungs_ - 1];
+    if (rung.size == 0) {
+      --active_rungs_;
+      continue;
+    }
+    while (rung.buckets[rung.current].empty()) {
+      ++rung.current;
+    }
+
+    scratch_.clear();
+    scratch_.swap(rung.buckets[rung.current]);
+    ++rung.current;
+    rung.size -= scratch_.size();
+
+    if (scratch_.size() > BUCKET_THRESHOLD && active_rungs_ < MAX_RUNGS) {
+      auto [min_it, max_it] = std::minmax_element(
+          scratch_.begin(), scratch_.end(), [](const Event& a, const Event& b) {
+            return a.get_time() < b.get_time();
+          });
+      double min = min_it->get_time();
+      double max = max_it->get_time();
+      if (max > min) {
+        spawn_rung(min, max);
+        continue;
+      }
+    }
+    sort_into_bottom();
+  }
+}
+
+void LadderQueue::spawn_rung(double start, double end) {
+  // Spreads scratch_ over a new lowest rung covering [start, end]
+  size_t count = scratch_.size();
+  if (active_rungs_ == rungs_.size()) {
+    rungs_.emplace_back();
+  }
+  Rung& rung = rungs_[active_rungs_];
+  rung.start = start;
+  rung.width = (end - start) / static_cast<double>(count);
+  rung.current = 0;
+  rung.size = count;
+  for (auto& bucket : rung.buckets) {
+    bucket.clear();
+  }
+  rung.buckets.resize(count + 1);
+  ++active_rungs_;
+
+  if (!(rung.width > 0.0)) {
+    // Range too narrow to be split; keep everything in one bucket
+    rung.width = INF;
+  }
+  for (const auto& event : scratch_) {
+    rung.buckets[bucket_index(rung, event.get_time())].push_back(event);
+  }
+  scratch_.clear();
+}
+
+void LadderQueue::sort_into_bottom() {
+  // Lazy sorting: only the batch about to be dequeued is ever sorted
+  std::sort(scratch_.begin(), scratch_.end(), fires_first);
+  bottom_.swap(scratch_);
+  bottom_head_ = 0;
+  scratch_.clear();
+}
+
+size_t LadderQueue::get_size() const { return size_; }
+
+bool LadderQueue::is_empty() const { return size_ == 0; }
+
+void LadderQueue::clear() {
+  top_.clear();
+  top_start_ = -INF;
+  top_min_ = INF;
+  top_max_ = -INF;
+  for (size_t i = 0; i < active_rungs_; ++i) {
+    for (auto& bucket : rungs_[i].buckets) {
+      bucket.clear();
+    }
+  }
+  active_rungs_ = 0;
+  bottom_.clear();
+  bottom_head_ = 0;
+  size_ = 0;
+}
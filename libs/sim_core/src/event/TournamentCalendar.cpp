@@ -0,0 +1,171 @@
+#include "sim/event/TournamentCalendar.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr double EMPTY_SLOT = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+TournamentCalendar::TournamentCalendar(size_t num_sources, size_t num_devices)
+    : num_sources_(num_sources),
+      slot_count_(num_sources + num_devices),
+      leaf_count_(1),
+      times_(slot_count_ + 1, EMPTY_SLOT),
+      sequences_(slot_count_ + 1, 0),
+      occupied_(slot_count_ + 1, 0),
+      size_(0) {
+  while (leaf_count_ < slot_count_) {
+    leaf_count_ *= 2;
+  }
+  // Padding leaves point at the trailing sentinel slot, which stays empty
+  // and loses every tie to a real slot.
+  tree_.assign(2 * leaf_count_, slot_count_);
+  for (size_t slot = 0; slot < slot_count_; ++slot) {
+    tree_[leaf_count_ + slot] = slot;
+  }
+  rebuild();
+}
+
+size_t TournamentCalendar::slot_of(const Event& event) const {
+  size_t slot;
+  if (event.get_type() == EventType::arrival) {
+    slot = event.get_source_id();
+    if (slot >= num_sources_) {
+      throw std::out_of_range("Source ID out of range");
+    }
+  } else {
+    slot = num_sources_ + event.get_device_id();
+    if (slot >= slot_count_) {
+      throw std::out_of_range("Device ID out of range");
+    }
+  }
+  return slot;
+}
+
+size_t TournamentCalendar::occupy(const Event& event) {
+  size_t slot = slot_of(event);
+  if (occupied_[slot] != 0) {
+    throw std::logic_error(
+        slot < num_sources_
+            ? "Source " + std::to_string(slot) +
+                  " already has a pending arrival"
+            : "Device " + std::to_string(slot - num_sources_) +
+                  " already has a pending service end");
+  }
+  times_[slot] = event.get_time();
+  sequences_[slot] = event.get_sequence();
+  occupied_[slot] = 1;
+  ++size_;
+  return slot;
+}
+
+void TournamentCalendar::vacate(size_t slot) {
+  times_[slot] = EMPTY_SLOT;
+  sequences_[slot] = 0;
+  occupied_[slot] = 0;
+  --size_;
+  update(slot);
+}
+
+Event TournamentCalendar::make_event(size_t slot) const {
+  Event event = slot < num_sources_
+                    ? Event(times_[slot], EventType::arrival, slot)
+                    : Event(times_[slot], EventType::service_end,
+                            slot - num_sources_);
+  event.set_sequence(sequences_[slot]);
+  return event;
+}
+
+bool TournamentCalendar::wins(size_t lhs, size_t rhs) const {
+  if (times_[lhs] != times_[rhs]) return times_[lhs] < times_[rhs];
+  // Only ties pay for this: an event at +inf beats an empty slot
+  if (occupied_[lhs] != occupied_[rhs]) return occupied_[lhs] != 0;
+  if (sequences_[lhs] != sequences_[rhs]) {
+    return is_scheduled_before(sequences_[lhs], sequences_[rhs]);
+  }
+  return lhs < rhs;
+}
+
+void TournamentCalendar::update(size_t slot) {
+  for (size_t node = (leaf_count_ + slot) / 2; node > 0; node /= 2) {
+    size_t left = tree_[2 * node];
+    size_t right = tree_[2 * node + 1];
+    tree_[node] = wins(right, left) ? right : left;
+  }
+}
+
+void TournamentCalendar::rebuild() {
+  for (size_t node = leaf_count_ - 1; node > 0; --node) {
+    size_t left = tree_[2 * node];
+    size_t right = tree_[2 * node + 1];
+    tree_[node] = wins(right, left) ? right : left;
+  }
+}
+
+void TournamentCalendar::schedule_bulk(std::span<const Event> events) {
+  // Replaying every leaf-to-root path costs O(k log n); past a few percent
+  // of the slots a full O(n) rebuild of the tree is cheaper
+  bool full_rebuild = events.size() * 16 >= slot_count_;
+  try {
+    for (const auto& event : events) {
+      size_t slot = occupy(event);
+      if (!full_rebuild) {
+        update(slot);
+      }
+    }
+  } catch (...) {
+    // The events before the bad one stay scheduled
+    if (full_rebuild) {
+      rebuild();
+    }
+    throw;
+  }
+  if (full_rebuild) {
+    rebuild();
+  }
+}
+
+void TournamentCalendar::schedule(const Event& event) {
+  update(occupy(event));
+}
+
+Event TournamentCalendar::pop_next() {
+  size_t slot = tree_[1];
+  Event event = make_event(slot);
+  vacate(slot);
+  return event;
+}
+
+bool TournamentCalendar::remove(const Event& event) {
+  size_t slot = slot_of(event);
+  if (occupied_[slot] != 0 && sequences_[slot] == event.get_sequence()) {
+    vacate(slot);
+  }
+  return true;  // otherwise the event is not pending
+}
+
+void TournamentCalendar::pop_batch(std::vector<Event>& batch) {
+  double time = times_[tree_[1]];
+  do {
+    batch.push_back(pop_next());
+  } while (size_ > 0 && times_[tree_[1]] == time);
+}
+
+Event TournamentCalendar::peek_next() const { return make_event(tree_[1]); }
+
+size_t TournamentCalendar::get_size() const { return size_; }
+
+bool TournamentCalendar::is_empty() const { return size_ == 0; }
+
+void TournamentCalendar::clear() {
+  std::fill(times_.begin(), times_.end(), EMPTY_SLOT);
+  std::fill(sequences_.begin(), sequences_.end(), 0);
+  std::fill(occupied_.begin(), occupied_.end(), 0);
+  size_ = 0;
+  rebuild();
+}
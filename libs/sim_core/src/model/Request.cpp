@@ -1,9 +1,7 @@
 #include "sim/model/Request.h"
 
-size_t Request::next_id_ = 1;
-
-Request::Request(size_t source_id, double t_arrival)
-    : id_(next_id_++),
+Request::Request(size_t id, size_t source_id, double t_arrival)
+    : id_(id),
       source_id_(source_id),
       t_arrival_(t_arrival),
       t_service_start_(0.0) {}
@@ -0,0 +1,62 @@
+#include "sim/model/RequestPool.h"
+
+#include <stdexcept>
+
+RequestPool::RequestPool(size_t initial_capacity) : next_id_(1) {
+  slab_.reserve(initial_capacity);
+  free_list_.reserve(initial_capacity);
+}
+
+RequestHandle RequestPool::acquire(size_t source_id, double t_arrival) {
+  if (!free_list_.empty()) {
+    RequestHandle handle = free_list_.back();
+    free_list_.pop_back();
+    slab_[handle] = Request(next_id_++, source_id, t_arrival);
+    return handle;
+  }
+  if (slab_.size() >= NO_REQUEST) {
+    throw std::length_error("Request pool exhausted");
+  }
+  slab_.emplace_back(next_id_++, source_id, t_arrival);
+  // Keep the free list able to hold every slot so release never allocates
+  free_list_.reserve(slab_.capacity());
+  return static_cast<RequestHandle>(slab_.size() - 1);
+}
+
+void RequestPool::release(RequestHandle handle) {
+  if (handle >= slab_.size()) {
+    throw std::out_of_range("Request handle out of range");
+  }
+  free_list_.push_back(handle);
+}
+
+Request& RequestPool::get(RequestHandle handle) {
+  if (handle >= slab_.size()) {
+    throw std::out_of_range("Request handle out of range");
+  }
+  return slab_[handle];
+}
+
+const Request& RequestPool::get(RequestHandle handle) const {
+  if (handle >= slab_.size()) {
+    throw std::out_of_range("Request handle out of range");
+  }
+  return slab_[handle];
+}
+
+size_t RequestPool::get_live_count() const {
+  return slab_.size() - free_list_.size();
+}
+
+size_t RequestPool::get_capacity() const { return slab_.size(); }
+
+void RequestPool::clear() {
+  slab_.clear();
+  free_list_.clear();
+  next_id_ = 1;
+}
+
+void RequestPool::reserve(size_t capacity) {
+  slab_.reserve(capacity);
+  free_list_.reserve(capacity);
+}
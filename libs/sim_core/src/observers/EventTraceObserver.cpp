@@ -0,0 +1,337 @@
+#include "sim/observers/EventTraceObserver.h"
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "sim/utils/AppendFile.h"
+
+// Encodes the blocks on its own thread, which also takes the page faults
+// of first writing into the mapping
+class EventTraceObserver::Writer {
+ public:
+  // Throws std::runtime_error if the file cannot be created
+  explicit Writer(const std::string& path);
+  // Stops the thread; what it has not written yet is lost
+  ~Writer();
+
+  // Queues the first size records of block and swaps in an empty block,
+  // waiting while MAX_BLOCKS are queued. Rethrows a write error, leaving
+  // the block to the caller.
+  void exchange(std::unique_ptr<TraceRecord[]>& block, size_t size);
+  // Writes the queued blocks, then these records, the last chunk and the
+  // index, and closes the file. Rethrows a write error.
+  void finish(const TraceRecord* records, size_t count);
+
+ private:
+  // Blocks in flight, queued or being written
+  static constexpr size_t MAX_BLOCKS = 8;
+
+  struct Block {
+    std::unique_ptr<TraceRecord[]> records;
+    size_t size;
+  };
+
+  void run();
+  void stop();
+
+  void write(const TraceRecord* records, size_t count);
+  // Encodes records into the chunk until it is full or one goes back in
+  // time, and returns how many it took
+  size_t encode(const TraceRecord* records, size_t count);
+  void begin_chunk(uint64_t time_bits, size_t request_id);
+  void end_chunk();
+
+  AppendFile file_;
+  std::vector<EventTrace::IndexEntry> index_;
+  uint64_t record_count_;
+
+  // The chunk being written: its header, the next record, and the values
+  // the next record is relative to
+  std::byte* chunk_;
+  std::byte* out_;
+  size_t chunk_records_;
+  uint64_t time_bits_;
+  size_t request_id_;
+
+  // Shared with the simulation thread
+  std::mutex mutex_;
+  std::condition_variable queued_;
+  std::condition_variable written_;
+  std::deque<Block> queue_;
+  std::vector<std::unique_ptr<TraceRecord[]>> free_blocks_;
+  size_t block_count_;
+  bool stopping_;
+  std::exception_ptr error_;
+
+  std::thread thread_;
+};
+
+EventTraceObserver::Writer::Writer(const std::string& path)
+    : file_(path),
+      record_count_(0),
+      chunk_(nullptr),
+      out_(nullptr),
+      chunk_records_(EventTrace::CHUNK_RECORDS),
+      time_bits_(0),
+      request_id_(0),
+      block_count_(1),  // the simulation thread's
+      stopping_(false) {
+  file_.append(EventTrace::MAGIC, sizeof(EventTrace::MAGIC));
+  if (has_writer_thread()) {
+    thread_ = std::thread([this] { run(); });
+  }
+}
+
+EventTraceObserver::Writer::~Writer() { stop(); }
+
+void EventTraceObserver::Writer::exchange(
+    std::unique_ptr<TraceRecord[]>& block, size_t size) {
+  if (!thread_.joinable()) {
+    write(block.get(), size);
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  queue_.push_back({std::move(block), size});
+  queued_.notify_one();
+  if (free_blocks_.empty() && block_count_ < MAX_BLOCKS) {
+    ++block_count_;
+    block.reset(new TraceRecord[BLOCK_RECORDS]);
+    return;
+  }
+  written_.wait(lock, [this] { return !free_blocks_.empty(); });
+  block = std::move(free_blocks_.back());
+  free_blocks_.pop_back();
+}
+
+void EventTraceObserver::Writer::finish(const TraceRecord* records,
+                                        size_t count) {
+  stop();
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  write(records, count);
+  end_chunk();
+  // Any further record asks for a chunk, which the closed file refuses
+  chunk_records_ = EventTrace::CHUNK_RECORDS;
+
+  EventTrace::Trailer trailer{file_.get_size(), index_.size(), record_count_,
+                              {}};
+  std::memcpy(trailer.magic, EventTrace::INDEX_MAGIC, sizeof(trailer.magic));
+  file_.append(index_.data(), index_.size() * sizeof(EventTrace::IndexEntry));
+  file_.append(&trailer, sizeof(trailer));
+  file_.close();
+}
+
+void EventTraceObserver::Writer::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+    if (queue_.empty()) {
+      return;
+    }
+    Block block = std::move(queue_.front());
+    queue_.pop_front();
+    bool failed = error_ != nullptr;
+    lock.unlock();
+
+    std::exception_ptr error;
+    if (!failed) {
+      try {
+        write(block.records.get(), block.size);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    if (error) {
+      error_ = error;
+    }
+    free_blocks_.push_back(std::move(block.records));
+    written_.notify_one();
+  }
+}
+
+void EventTraceObserver::Writer::stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  queued_.notify_one();
+  thread_.join();
+}
+
+void EventTraceObserver::Writer::write(const TraceRecord* records,
+                                       size_t count) {
+  while (count > 0) {
+    // Times are never negative, so their bit patterns order like them
+    auto time_bits = std::bit_cast<uint64_t>(records->time);
+    if (chunk_records_ == EventTrace::CHUNK_RECORDS ||
+        time_bits < time_bits_) {
+      begin_chunk(time_bits, records->request_id);
+    }
+    size_t encoded = encode(records, count);
+    records += encoded;
+    count -= encoded;
+  }
+}
+
+// The state lives in locals, which the byte stores cannot alias, and the
+// kinds without a device or slot skip their pair without a branch
+size_t EventTraceObserver::Writer::encode(const TraceRecord* records,
+                                          size_t count) {
+  constexpr unsigned PAIR_KINDS =
+      1u << static_cast<unsigned>(EventKind::ServiceStart) |
+      1u << static_cast<unsigned>(EventKind::ServiceEnd) |
+      1u << static_cast<unsigned>(EventKind::BufferPlace) |
+      1u << static_cast<unsigned>(EventKind::BufferTake);
+  count = std::min(count, EventTrace::CHUNK_RECORDS - chunk_records_);
+  std::byte* out = out_;
+  uint64_t last_time_bits = time_bits_;
+  uint64_t last_request_id = request_id_;
+  size_t encoded = 0;
+  for (; encoded < count; ++encoded) {
+    const TraceRecord& record = records[encoded];
+    auto time_bits = std::bit_cast<uint64_t>(record.time);
+    if (time_bits < last_time_bits) {
+      break;
+    }
+    uint64_t time_delta = time_bits - last_time_bits;
+    unsigned time_length = EventTrace::get_length(time_delta);
+    auto kind = static_cast<unsigned>(record.kind);
+    *out = static_cast<std::byte>(kind | time_length << 3);
+    out = EventTrace::put_field(out + 1, time_delta, time_length);
+    out = EventTrace::put_pair(
+        out,
+        EventTrace::zigzag(static_cast<uint64_t>(record.request_id) -
+                           last_request_id),
+        record.source_id);
+    // Absent fields are 0
+    std::byte* end =
+        EventTrace::put_pair(out, record.device_id, record.buffer_slot);
+    out = (PAIR_KINDS >> kind & 1) != 0 ? end : out;
+    last_time_bits = time_bits;
+    last_request_id = record.request_id;
+  }
+  out_ = out;
+  time_bits_ = last_time_bits;
+  request_id_ = last_request_id;
+  chunk_records_ += encoded;
+  record_count_ += encoded;
+  return encoded;
+}
+
+// The header is complete once the chunk ends; until then its record count
+// stays 0, which is where a reader of a cut-short trace stops
+void EventTraceObserver::Writer::begin_chunk(uint64_t time_bits,
+                                             size_t request_id) {
+  end_chunk();
+  chunk_ = file_.reserve(EventTrace::MAX_CHUNK_BYTES);
+  out_ = chunk_ + sizeof(EventTrace::ChunkHeader);
+
+  EventTrace::ChunkHeader header{0, 0, std::bit_cast<double>(time_bits),
+                                 request_id, record_count_};
+  std::memcpy(chunk_, &header, sizeof(header));
+  index_.push_back({header.first_time, file_.get_size(), record_count_});
+  chunk_records_ = 0;
+  time_bits_ = time_bits;
+  request_id_ = request_id;
+}
+
+void EventTraceObserver::Writer::end_chunk() {
+  if (chunk_ == nullptr) {
+    return;
+  }
+  EventTrace::ChunkHeader header;
+  std::memcpy(&header, chunk_, sizeof(header));
+  header.record_count = static_cast<uint32_t>(chunk_records_);
+  header.payload_bytes =
+      static_cast<uint32_t>(out_ - chunk_ - sizeof(EventTrace::ChunkHeader));
+  std::memcpy(chunk_, &header, sizeof(header));
+  file_.commit(static_cast<size_t>(out_ - chunk_));
+  chunk_ = nullptr;
+}
+
+// On a single core the handoffs cost more than they save
+bool EventTraceObserver::has_writer_thread() {
+  return std::thread::hardware_concurrency() > 1;
+}
+
+EventTraceObserver::EventTraceObserver()
+    : block_size_(BLOCK_RECORDS), record_count_(0) {}
+
+EventTraceObserver::EventTraceObserver(const std::string& path)
+    : EventTraceObserver() {
+  open(path);
+}
+
+EventTraceObserver::EventTraceObserver(EventTraceObserver&& other) noexcept
+    : writer_(std::move(other.writer_)),
+      block_(std::move(other.block_)),
+      block_size_(std::exchange(other.block_size_, BLOCK_RECORDS)),
+      record_count_(std::exchange(other.record_count_, 0)) {}
+
+EventTraceObserver::~EventTraceObserver() {
+  try {
+    finish();
+  } catch (const std::runtime_error&) {
+  }
+}
+
+// One direct call per event instead of a virtual one
+void EventTraceObserver::on_events(std::span<const SimulationEvent> events) {
+  for (const auto& event : events) {
+    std::visit([this](const auto& typed) { add(to_record(typed)); }, event);
+  }
+}
+
+void EventTraceObserver::open(const std::string& path) {
+  finish();
+  writer_ = std::make_unique<Writer>(path);
+  if (block_ == nullptr) {
+    block_.reset(new TraceRecord[BLOCK_RECORDS]);
+  }
+  block_size_ = 0;
+  record_count_ = 0;
+}
+
+void EventTraceObserver::finish() {
+  if (writer_ == nullptr) {
+    return;
+  }
+  // Closed from here on, even if writing fails
+  std::unique_ptr<Writer> writer = std::move(writer_);
+  size_t size = block_size_;
+  record_count_ += size;
+  block_size_ = BLOCK_RECORDS;
+  writer->finish(block_.get(), size);
+}
+
+void EventTraceObserver::hand_off() {
+  if (writer_ == nullptr) {
+    if (block_ == nullptr) {
+      block_.reset(new TraceRecord[BLOCK_RECORDS]);
+    }
+    block_size_ = 0;
+    return;
+  }
+  writer_->exchange(block_, block_size_);
+  record_count_ += block_size_;
+  block_size_ = 0;
+}
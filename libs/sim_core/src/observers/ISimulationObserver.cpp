@@ -0,0 +1,28 @@
+#include "sim/observers/ISimulationObserver.h"
+
+#include <type_traits>
+
+void ISimulationObserver::on_events(std::span<const SimulationEvent> events) {
+  for (const auto& event : events) {
+    std::visit(
+        [this](const auto& typed) {
+          using Event = std::decay_t<decltype(typed)>;
+          if constexpr (std::is_same_v<Event, ArrivalEvent>) {
+            on_arrival(typed);
+          } else if constexpr (std::is_same_v<Event, ServiceStartEvent>) {
+            on_service_start(typed);
+          } else if constexpr (std::is_same_v<Event, ServiceEndEvent>) {
+            on_service_end(typed);
+          } else if constexpr (std::is_same_v<Event, BufferPlaceEvent>) {
+            on_buffer_place(typed);
+          } else if constexpr (std::is_same_v<Event, BufferTakeEvent>) {
+            on_buffer_take(typed);
+          } else if constexpr (std::is_same_v<Event, BufferDisplacedEvent>) {
+            on_buffer_displaced(typed);
+          } else {
+            on_refusal(typed);
+          }
+        },
+        event);
+  }
+}
@@ -0,0 +1,39 @@
+#include "sim/queue/FifoPolicy.h"
+
+FifoPolicy::FifoPolicy(size_t capacity, bool displace_oldest)
+    : head_(0), count_(0), displace_oldest_(displace_oldest) {
+  reset(capacity);
+}
+
+size_t FifoPolicy::place(RequestHandle request, size_t /*source_id*/) {
+  size_t slot = (head_ + count_) % ring_.size();
+  ring_[slot] = request;
+  ++count_;
+  return slot;
+}
+
+std::pair<RequestHandle, size_t> FifoPolicy::take() {
+  size_t slot = head_;
+  RequestHandle request = ring_[slot];
+  ring_[slot] = NO_REQUEST;
+  head_ = (head_ + 1) % ring_.size();
+  --count_;
+  return {request, slot};
+}
+
+RequestHandle FifoPolicy::displace(size_t /*source_id*/) {
+  if (displace_oldest_) {
+    return take().first;
+  }
+  size_t slot = (head_ + count_ - 1) % ring_.size();
+  RequestHandle request = ring_[slot];
+  ring_[slot] = NO_REQUEST;
+  --count_;
+  return request;
+}
+
+void FifoPolicy::reset(size_t capacity) {
+  ring_.assign(capacity, NO_REQUEST);
+  head_ = 0;
+  count_ = 0;
+}
@@ -0,0 +1,23 @@
+#include "sim/queue/LifoPolicy.h"
+
+LifoPolicy::LifoPolicy(size_t capacity) { reset(capacity); }
+
+size_t LifoPolicy::place(RequestHandle request, size_t /*source_id*/) {
+  stack_.push_back(request);
+  return stack_.size() - 1;
+}
+
+std::pair<RequestHandle, size_t> LifoPolicy::take() {
+  RequestHandle request = stack_.back();
+  stack_.pop_back();
+  return {request, stack_.size()};
+}
+
+RequestHandle LifoPolicy::displace(size_t /*source_id*/) {
+  return take().first;
+}
+
+void LifoPolicy::reset(size_t capacity) {
+  stack_.clear();
+  stack_.reserve(capacity);
+}
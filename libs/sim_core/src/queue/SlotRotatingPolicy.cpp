@@ -0,0 +1,74 @@
+#include "sim/queue/SlotRotatingPolicy.h"
+
+SlotRotatingPolicy::SlotRotatingPolicy(size_t capacity) { reset(capacity); }
+
+size_t SlotRotatingPolicy::place(RequestHandle request,
+                                 size_t /*source_id*/) {
+  // First free slot starting from index 0
+  size_t idx = free_.find_next(0);
+  slots_[idx] = request;
+  occupied_.set(idx);
+  free_.reset(idx);
+  ++size_;
+  place_start_ = idx;  // Track last placed position
+  return idx;
+}
+
+RequestHandle SlotRotatingPolicy::displace(size_t /*source_id*/) {
+  // Search backwards from the last placed position,
+  // wrapping around past the beginning
+  size_t idx = occupied_.find_prev(place_start_);
+  if (idx == IndexBitmap::NPOS) {
+    idx = occupied_.find_prev(capacity_ - 1);
+  }
+
+  RequestHandle displaced_request = slots_[idx];
+  slots_[idx] = NO_REQUEST;
+  occupied_.reset(idx);
+  free_.set(idx);
+  --size_;
+  // Update place_start_ to point to the slot before the displaced one
+  // This ensures next displacement continues from the correct position
+  place_start_ = (idx - 1 + capacity_) % capacity_;
+  return displaced_request;
+}
+
+std::pair<RequestHandle, size_t> SlotRotatingPolicy::take() {
+  // Take first occupied slot starting from select_start_
+  // (round-robin selection)
+  size_t idx = occupied_.find_next(select_start_);
+  if (idx == IndexBitmap::NPOS) {
+    idx = occupied_.find_next(0);
+  }
+
+  RequestHandle request = slots_[idx];
+  slots_[idx] = NO_REQUEST;               // Clear slot
+  occupied_.reset(idx);
+  free_.set(idx);
+  select_start_ = (idx + 1) % capacity_;  // Rotate start pointer
+  --size_;
+
+  // If we removed the request at place_start_, update place_start_
+  // to point to the previous occupied slot, wrapping around
+  // (for correct displacement tracking)
+  if (idx == place_start_ && size_ > 0) {
+    size_t prev_idx =
+        idx > 0 ? occupied_.find_prev(idx - 1) : IndexBitmap::NPOS;
+    if (prev_idx == IndexBitmap::NPOS) {
+      prev_idx = occupied_.find_prev(capacity_ - 1);
+    }
+    place_start_ = prev_idx;
+  }
+
+  return {request, idx};  // Return request and slot index
+}
+
+void SlotRotatingPolicy::reset(size_t capacity) {
+  capacity_ = capacity;
+  size_ = 0;
+  place_start_ = 0;
+  select_start_ = 0;
+  slots_.assign(capacity_, NO_REQUEST);
+  occupied_.assign(capacity_, false);
+  free_.assign(capacity_, true);
+}
@@ -0,0 +1,92 @@
+#include "sim/queue/SourcePriorityPolicy.h"
+
+#include <stdexcept>
+
+SourcePriorityPolicy::SourcePriorityPolicy(size_t capacity) {
+  reset(capacity);
+}
+
+size_t SourcePriorityPolicy::place(RequestHandle request, size_t source_id) {
+  if (source_id >= sources_.size()) {
+    add_sources(source_id + 1);
+  }
+
+  uint32_t slot = free_slots_.back();
+  free_slots_.pop_back();
+  SourceList& list = sources_[source_id];
+  slots_[slot] = {request, list.tail, NO_SLOT};
+  if (list.tail == NO_SLOT) {
+    list.head = slot;
+    non_empty_.set(source_id);
+  } else {
+    slots_[list.tail].next = slot;
+  }
+  list.tail = slot;
+  return slot;
+}
+
+std::pair<RequestHandle, size_t> SourcePriorityPolicy::take() {
+  size_t source_id = non_empty_.find_next(0);
+  uint32_t slot = sources_[source_id].head;
+  return {unlink(source_id, slot), slot};
+}
+
+RequestHandle SourcePriorityPolicy::displace(size_t source_id) {
+  size_t lowest = non_empty_.find_prev(IndexBitmap::NPOS);
+  // An arrival no more urgent than anything stored is the one to lose
+  if (source_id >= lowest) {
+    return NO_REQUEST;
+  }
+  return unlink(lowest, sources_[lowest].tail);
+}
+
+void SourcePriorityPolicy::reset(size_t capacity) {
+  if (capacity >= NO_SLOT) {
+    throw std::length_error("Buffer capacity too large");
+  }
+  slots_.assign(capacity, Slot{});
+  // Lowest slots are handed out first
+  free_slots_.clear();
+  for (size_t slot = capacity; slot-- > 0;) {
+    free_slots_.push_back(static_cast<uint32_t>(slot));
+  }
+  for (auto& list : sources_) {
+    list = SourceList{};
+  }
+  non_empty_.assign(sources_.size(), false);
+}
+
+void SourcePriorityPolicy::add_sources(size_t count) {
+  // Rebuild the bitmap at the new size; only happens when a source id is
+  // first seen
+  sources_.resize(count);
+  non_empty_.assign(count, false);
+  for (size_t source_id = 0; source_id < count; ++source_id) {
+    if (sources_[source_id].head != NO_SLOT) {
+      non_empty_.set(source_id);
+    }
+  }
+}
+
+RequestHandle SourcePriorityPolicy::unlink(size_t source_id, uint32_t slot) {
+  SourceList& list = sources_[source_id];
+  Slot& node = slots_[slot];
+  if (node.prev == NO_SLOT) {
+    list.head = node.next;
+  } else {
+    slots_[node.prev].next = node.next;
+  }
+  if (node.next == NO_SLOT) {
+    list.tail = node.prev;
+  } else {
+    slots_[node.next].prev = node.prev;
+  }
+  if (list.head == NO_SLOT) {
+    non_empty_.reset(source_id);
+  }
+
+  RequestHandle request = node.request;
+  node = Slot{};
+  free_slots_.push_back(slot);
+  return request;
+}
@@ -1,11 +1,224 @@
 #include "sim/simulator/ConfigurationManager.h"
 
 #include "sim/device/DevicePool.h"
+#include "sim/device/FastestFreeStrategy.h"
+#include "sim/device/FixedPriorityStrategy.h"
+#include "sim/device/LeastBusyTimeStrategy.h"
+#include "sim/device/RandomStrategy.h"
 #include "sim/device/RoundRobinStrategy.h"
+#include "sim/event/BinaryHeapCalendar.h"
+#include "sim/event/CalendarQueue.h"
+#include "sim/event/LadderQueue.h"
+#include "sim/event/TournamentCalendar.h"
+#include "sim/queue/FifoPolicy.h"
+#include "sim/queue/LifoPolicy.h"
+#include "sim/queue/SlotRotatingPolicy.h"
+#include "sim/queue/SourcePriorityPolicy.h"
 #include "sim/source/Source.h"
 #include "sim/source/SourcePool.h"
 #include "sim/utils/ConstantDistribution.h"
+#include "sim/utils/EmpiricalDistribution.h"
+#include "sim/utils/ErlangDistribution.h"
 #include "sim/utils/ExponentialDistribution.h"
+#include "sim/utils/HyperexponentialDistribution.h"
+#include "sim/utils/LognormalDistribution.h"
+#include "sim/utils/ParetoDistribution.h"
+#include "sim/utils/Pcg64.h"
+#include "sim/utils/Philox4x32.h"
+#include "sim/utils/RandomEngine.h"
+#include "sim/utils/SplitMix64.h"
+#include "sim/utils/TraceDistribution.h"
+#include "sim/utils/TruncatedNormalDistribution.h"
+#include "sim/utils/UniformDistribution.h"
+#include "sim/utils/WeibullDistribution.h"
+#include "sim/utils/Xoshiro256PlusPlus.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool engine_matches(const IRandomEngine& engine, RngType type) {
+  switch (type) {
+    case RngType::Pcg64:
+      return dynamic_cast<const RandomEngine<Pcg64>*>(&engine) != nullptr;
+    case RngType::Philox4x32:
+      return dynamic_cast<const RandomEngine<Philox4x32>*>(&engine) !=
+             nullptr;
+    case RngType::SplitMix64:
+      return dynamic_cast<const RandomEngine<SplitMix64>*>(&engine) !=
+             nullptr;
+    case RngType::Mt19937:
+      return dynamic_cast<const RandomEngine<std::mt19937>*>(&engine) !=
+             nullptr;
+    case RngType::Xoshiro256PlusPlus:
+    default:
+      return dynamic_cast<const RandomEngine<Xoshiro256PlusPlus>*>(
+                 &engine) != nullptr;
+  }
+}
+
+TraceColumn trace_column(DistributionType type) {
+  return type == DistributionType::TraceServiceTimes
+             ? TraceColumn::ServiceTimes
+             : TraceColumn::Timestamps;
+}
+
+// Devices replaying the same service trace file each take a slice of it,
+// in device order
+struct TraceSlice {
+  size_t part = 0;
+  size_t parts = 1;
+};
+
+TraceSlice service_trace_slice(const SimulationConfig& config,
+                               size_t device) {
+  const DeviceConfig& own = config.devices[device];
+  TraceSlice slice;
+  if (own.service_distribution_type != DistributionType::TraceServiceTimes) {
+    return slice;
+  }
+  slice.parts = 0;
+  for (size_t i = 0; i < config.devices.size(); ++i) {
+    const DeviceConfig& other = config.devices[i];
+    if (other.service_distribution_type ==
+            DistributionType::TraceServiceTimes &&
+        other.service_file == own.service_file) {
+      slice.part += i < device ? 1 : 0;
+      ++slice.parts;
+    }
+  }
+  return slice;
+}
+
+std::unique_ptr<IDistribution> create_service_distribution(
+    const SimulationConfig& config, size_t device,
+    HistogramCache& histograms) {
+  const DeviceConfig& device_config = config.devices[device];
+  if (device_config.service_distribution_type ==
+      DistributionType::TraceServiceTimes) {
+    TraceSlice slice = service_trace_slice(config, device);
+    return std::make_unique<TraceDistribution>(
+        device_config.service_parameter, device_config.service_file,
+        TraceColumn::ServiceTimes, device_config.loop_service_file,
+        slice.part, slice.parts);
+  }
+  return ConfigurationManager::create_distribution(
+      device_config.service_distribution_type,
+      device_config.service_parameter, device_config.service_shape,
+      ConfigurationManager::get_stream_id(config, StreamKind::Device, device),
+      config.rng_type, device_config.service_file,
+      device_config.loop_service_file, &histograms);
+}
+
+template <class Distribution>
+bool is_a(const IDistribution& distribution) {
+  return dynamic_cast<const Distribution*>(&distribution) != nullptr;
+}
+
+bool has_type(const IDistribution& distribution, DistributionType type) {
+  switch (type) {
+    case DistributionType::Constant:
+      return is_a<ConstantDistribution>(distribution);
+    case DistributionType::Erlang:
+      return is_a<ErlangDistribution>(distribution);
+    case DistributionType::Hyperexponential:
+      return is_a<HyperexponentialDistribution>(distribution);
+    case DistributionType::Lognormal:
+      return is_a<LognormalDistribution>(distribution);
+    case DistributionType::Pareto:
+      return is_a<ParetoDistribution>(distribution);
+    case DistributionType::Uniform:
+      return is_a<UniformDistribution>(distribution);
+    case DistributionType::Weibull:
+      return is_a<WeibullDistribution>(distribution);
+    case DistributionType::TruncatedNormal:
+      return is_a<TruncatedNormalDistribution>(distribution);
+    case DistributionType::Empirical:
+      return is_a<EmpiricalDistribution>(distribution);
+    case DistributionType::TraceIntervals:
+    case DistributionType::TraceServiceTimes: {
+      auto* trace = dynamic_cast<const TraceDistribution*>(&distribution);
+      return trace != nullptr && trace->get_column() == trace_column(type);
+    }
+    case DistributionType::Exponential:
+    default:
+      return is_a<ExponentialDistribution>(distribution);
+  }
+}
+
+// Re-parametrizes the distribution in place if it already has the type
+// and, for random ones, the engine (and, for file-backed ones, the file
+// and whether it loops)
+bool update_distribution(IDistribution& distribution, DistributionType type,
+                         double param, double shape, const StreamId& stream,
+                         RngType rng_type, const std::string& path,
+                         bool loop, TraceSlice slice = {}) {
+  if (!has_type(distribution, type)) {
+    return false;
+  }
+  auto* random = dynamic_cast<RandomDistribution*>(&distribution);
+  if (random != nullptr && !engine_matches(random->get_engine(), rng_type)) {
+    return false;
+  }
+  auto* empirical = dynamic_cast<EmpiricalDistribution*>(&distribution);
+  if (empirical != nullptr && empirical->get_histogram_path() != path) {
+    return false;
+  }
+  auto* trace = dynamic_cast<TraceDistribution*>(&distribution);
+  if (trace != nullptr &&
+      (trace->get_path() != path || trace->is_looping() != loop ||
+       trace->get_part() != slice.part || trace->get_parts() != slice.parts)) {
+    return false;
+  }
+  distribution.set_parameter(param);
+  distribution.set_shape(shape);
+  distribution.reseed(stream);
+  return true;
+}
+
+// Every random distribution has mean 1 / intensity. Trace means are not
+// known without reading the trace; ranking them by playback rate is right
+// for devices replaying the same one.
+double mean_service_time(const DeviceConfig& device) {
+  switch (device.service_distribution_type) {
+    case DistributionType::Constant:
+      return device.service_parameter;
+    default:
+      return 1.0 / device.service_parameter;
+  }
+}
+
+bool valid_shape(DistributionType type, double shape) {
+  if (!std::isfinite(shape)) {
+    return false;
+  }
+  switch (type) {
+    case DistributionType::Erlang:
+    case DistributionType::Hyperexponential:
+      return shape >= 1.0;
+    case DistributionType::Pareto:
+      return shape > 1.0;
+    case DistributionType::Uniform:
+      return shape >= 0.0 && shape <= 1.0;
+    case DistributionType::Lognormal:
+    case DistributionType::Weibull:
+    case DistributionType::TruncatedNormal:
+      return shape > 0.0;
+    default:
+      return true;
+  }
+}
+
+bool reads_file(DistributionType type) {
+  return type == DistributionType::Empirical ||
+         type == DistributionType::TraceIntervals ||
+         type == DistributionType::TraceServiceTimes;
+}
+
+}  // namespace
 
 bool ConfigurationManager::validate(const SimulationConfig& config) {
   if (config.buffer_capacity == 0) return false;
@@ -16,34 +229,87 @@ bool ConfigurationManager::validate(const SimulationConfig& config) {
 
   for (const auto& source : config.sources) {
     if (source.arrival_parameter <= 0.0) return false;
+    if (!valid_shape(source.arrival_distribution_type, source.arrival_shape)) {
+      return false;
+    }
+    if (reads_file(source.arrival_distribution_type) &&
+        source.arrival_file.empty()) {
+      return false;
+    }
   }
 
   for (const auto& device : config.devices) {
     if (device.service_parameter <= 0.0) return false;
+    if (!valid_shape(device.service_distribution_type, device.service_shape)) {
+      return false;
+    }
+    if (reads_file(device.service_distribution_type) &&
+        device.service_file.empty()) {
+      return false;
+    }
   }
 
   return true;
 }
 
+void ConfigurationManager::check_service_traces(
+    const SimulationConfig& config) {
+  for (size_t i = 0; i < config.devices.size(); ++i) {
+    const DeviceConfig& device = config.devices[i];
+    if (device.service_distribution_type !=
+        DistributionType::TraceServiceTimes) {
+      continue;
+    }
+    // Only maps the file; throws itself if the slice would be empty
+    TraceSlice slice = service_trace_slice(config, i);
+    TraceDistribution trace(device.service_parameter, device.service_file,
+                            TraceColumn::ServiceTimes,
+                            device.loop_service_file, slice.part,
+                            slice.parts);
+    if (!trace.is_looping() && trace.get_size() < config.max_arrivals) {
+      throw std::invalid_argument(
+          "Device " + std::to_string(i) + " has " +
+          std::to_string(trace.get_size()) + " service times in " +
+          device.service_file + " for up to " +
+          std::to_string(config.max_arrivals) + " arrivals");
+    }
+  }
+}
+
 std::unique_ptr<IDeviceSelectionStrategy>
 ConfigurationManager::create_device_selection_strategy(
-    const SimulationConfig& /*config*/) {
-  return std::make_unique<RoundRobinStrategy>();
+    const SimulationConfig& config) {
+  switch (config.device_selection) {
+    case DeviceSelection::FastestFree: {
+      std::vector<double> means;
+      means.reserve(config.devices.size());
+      for (const auto& device : config.devices) {
+        means.push_back(mean_service_time(device));
+      }
+      return std::make_unique<FastestFreeStrategy>(means);
+    }
+    case DeviceSelection::LeastBusyTime:
+      return std::make_unique<LeastBusyTimeStrategy>(config.devices.size());
+    case DeviceSelection::FixedPriority:
+      return std::make_unique<FixedPriorityStrategy>();
+    case DeviceSelection::Random:
+      return std::make_unique<RandomStrategy>(
+          config.devices.size(),
+          get_stream_id(config, StreamKind::DeviceSelection, 0));
+    case DeviceSelection::RoundRobin:
+    default:
+      return std::make_unique<RoundRobinStrategy>();
+  }
 }
 
 std::unique_ptr<DevicePool> ConfigurationManager::create_device_pool(
-    const SimulationConfig& config) {
+    const SimulationConfig& config, HistogramCache& histograms) {
   auto strategy = create_device_selection_strategy(config);
   std::vector<std::unique_ptr<IDistribution>> distributions;
   
   for (size_t i = 0; i < config.devices.size(); ++i) {
-    const auto& device_config = config.devices[i];
-    
-    auto distribution = create_distribution(
-        device_config.service_distribution_type,
-        device_config.service_parameter,
-        config.seed + static_cast<uint32_t>(i));
-    distributions.push_back(std::move(distribution));
+    distributions.push_back(
+        create_service_distribution(config, i, histograms));
   }
   
   return std::make_unique<DevicePool>(
@@ -53,15 +319,17 @@ std::unique_ptr<DevicePool> ConfigurationManager::create_device_pool(
 }
 
 std::unique_ptr<SourcePool> ConfigurationManager::create_source_pool(
-    const SimulationConfig& config) {
+    const SimulationConfig& config, HistogramCache& histograms) {
   auto pool = std::make_unique<SourcePool>();
   for (size_t i = 0; i < config.sources.size(); ++i) {
     const auto& source_config = config.sources[i];
     
     auto distribution = create_distribution(
         source_config.arrival_distribution_type,
-        source_config.arrival_parameter,
-        config.seed + static_cast<uint32_t>(i));
+        source_config.arrival_parameter, source_config.arrival_shape,
+        get_stream_id(config, StreamKind::Source, i), config.rng_type,
+        source_config.arrival_file, source_config.loop_arrival_file,
+        &histograms);
     
     auto source = std::make_unique<Source>(i, std::move(distribution));
     pool->add_source(std::move(source));
@@ -69,15 +337,172 @@ std::unique_ptr<SourcePool> ConfigurationManager::create_source_pool(
   return pool;
 }
 
+void ConfigurationManager::configure_device_pool(
+    DevicePool& pool, const SimulationConfig& config,
+    HistogramCache& histograms) {
+  pool.truncate(config.devices.size());
+  for (size_t i = 0; i < config.devices.size(); ++i) {
+    const auto& device_config = config.devices[i];
+    StreamId stream = get_stream_id(config, StreamKind::Device, i);
+
+    if (i < pool.size()) {
+      Device& device = pool.get_device(i);
+      if (!update_distribution(device.get_distribution(),
+                               device_config.service_distribution_type,
+                               device_config.service_parameter,
+                               device_config.service_shape, stream,
+                               config.rng_type, device_config.service_file,
+                               device_config.loop_service_file,
+                               service_trace_slice(config, i))) {
+        device.set_distribution(
+            create_service_distribution(config, i, histograms));
+      }
+    } else {
+      pool.add_device(std::make_unique<Device>(
+          i, create_service_distribution(config, i, histograms)));
+    }
+  }
+  pool.set_strategy(create_device_selection_strategy(config));
+  pool.reset();
+}
+
+void ConfigurationManager::configure_source_pool(
+    SourcePool& pool, const SimulationConfig& config,
+    HistogramCache& histograms) {
+  pool.truncate(config.sources.size());
+  for (size_t i = 0; i < config.sources.size(); ++i) {
+    const auto& source_config = config.sources[i];
+    StreamId stream = get_stream_id(config, StreamKind::Source, i);
+
+    if (i < pool.size()) {
+      Source& source = pool.get_source(i);
+      if (!update_distribution(source.get_distribution(),
+                               source_config.arrival_distribution_type,
+                               source_config.arrival_parameter,
+                               source_config.arrival_shape, stream,
+                               config.rng_type, source_config.arrival_file,
+                               source_config.loop_arrival_file)) {
+        source.set_distribution(create_distribution(
+            source_config.arrival_distribution_type,
+            source_config.arrival_parameter, source_config.arrival_shape, stream,
+            config.rng_type, source_config.arrival_file,
+            source_config.loop_arrival_file, &histograms));
+      }
+    } else {
+      pool.add_source(std::make_unique<Source>(
+          i, create_distribution(source_config.arrival_distribution_type,
+                                 source_config.arrival_parameter,
+                                 source_config.arrival_shape, stream,
+                                 config.rng_type,
+                                 source_config.arrival_file,
+                                 source_config.loop_arrival_file,
+                                 &histograms)));
+    }
+  }
+  pool.reset();
+}
+
+std::unique_ptr<IEventCalendar> ConfigurationManager::create_event_calendar(
+    const SimulationConfig& config) {
+  switch (config.calendar_type) {
+    case CalendarType::CalendarQueue:
+      return std::make_unique<CalendarQueue>();
+    case CalendarType::LadderQueue:
+      return std::make_unique<LadderQueue>();
+    case CalendarType::Tournament:
+      return std::make_unique<TournamentCalendar>(config.sources.size(),
+                                                  config.devices.size());
+    case CalendarType::BinaryHeap:
+    default:
+      return std::make_unique<BinaryHeapCalendar>();
+  }
+}
+
+std::unique_ptr<IBufferPolicy> ConfigurationManager::create_buffer_policy(
+    const SimulationConfig& config) {
+  size_t capacity = config.buffer_capacity;
+  switch (config.buffer_discipline) {
+    case BufferDiscipline::Fifo:
+      return std::make_unique<FifoPolicy>(capacity, false);
+    case BufferDiscipline::Lifo:
+      return std::make_unique<LifoPolicy>(capacity);
+    case BufferDiscipline::SourcePriority:
+      return std::make_unique<SourcePriorityPolicy>(capacity);
+    case BufferDiscipline::DisplaceOldest:
+      return std::make_unique<FifoPolicy>(capacity, true);
+    case BufferDiscipline::SlotRotating:
+    default:
+      return std::make_unique<SlotRotatingPolicy>(capacity);
+  }
+}
+
+StreamId ConfigurationManager::get_stream_id(const SimulationConfig& config,
+                                             StreamKind kind, size_t id) {
+  return {config.seed, config.replication, kind, static_cast<uint32_t>(id)};
+}
+
+std::unique_ptr<IRandomEngine> ConfigurationManager::create_random_engine(
+    RngType type, const StreamId& stream) {
+  switch (type) {
+    case RngType::Pcg64:
+      return std::make_unique<RandomEngine<Pcg64>>(stream);
+    case RngType::Philox4x32:
+      return std::make_unique<RandomEngine<Philox4x32>>(stream);
+    case RngType::SplitMix64:
+      return std::make_unique<RandomEngine<SplitMix64>>(stream);
+    case RngType::Mt19937:
+      return std::make_unique<RandomEngine<std::mt19937>>(stream);
+    case RngType::Xoshiro256PlusPlus:
+    default:
+      return std::make_unique<RandomEngine<Xoshiro256PlusPlus>>(stream);
+  }
+}
+
 std::unique_ptr<IDistribution> ConfigurationManager::create_distribution(
-    DistributionType type, double param, uint32_t seed) {
+    DistributionType type, double param, double shape, const StreamId& stream,
+    RngType rng_type, const std::string& path, bool loop,
+    HistogramCache* histograms) {
   switch (type) {
     case DistributionType::Exponential:
-      return std::make_unique<ExponentialDistribution>(param, seed);
+      return std::make_unique<ExponentialDistribution>(
+          param, create_random_engine(rng_type, stream));
     case DistributionType::Constant:
       return std::make_unique<ConstantDistribution>(param);
+    case DistributionType::Erlang:
+      return std::make_unique<ErlangDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Hyperexponential:
+      return std::make_unique<HyperexponentialDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Lognormal:
+      return std::make_unique<LognormalDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Pareto:
+      return std::make_unique<ParetoDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Uniform:
+      return std::make_unique<UniformDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Weibull:
+      return std::make_unique<WeibullDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::TruncatedNormal:
+      return std::make_unique<TruncatedNormalDistribution>(
+          param, shape, create_random_engine(rng_type, stream));
+    case DistributionType::Empirical:
+      return std::make_unique<EmpiricalDistribution>(
+          param, path,
+          histograms != nullptr
+              ? histograms->load(path)
+              : std::make_shared<const Histogram>(Histogram::read(path)),
+          create_random_engine(rng_type, stream));
+    case DistributionType::TraceIntervals:
+    case DistributionType::TraceServiceTimes:
+      return std::make_unique<TraceDistribution>(param, path,
+                                                 trace_column(type), loop);
     default:
       // Default to exponential
-      return std::make_unique<ExponentialDistribution>(param, seed);
+      return std::make_unique<ExponentialDistribution>(
+          param, create_random_engine(rng_type, stream));
   }
 }
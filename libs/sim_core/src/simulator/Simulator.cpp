@@ -2,132 +2,135 @@
 
 #include <stdexcept>
 
-#include "sim/simulator/ConfigurationManager.h"
-#include "sim/event/Event.h"
-#include "sim/event/EventDispatcher.h"
-#include "sim/model/Request.h"
-#include "sim/observers/MetricsObserver.h"
+#include "sim/device/RoundRobinStrategy.h"
+#include "sim/event/BinaryHeapCalendar.h"
+#include "sim/event/CalendarQueue.h"
+#include "sim/event/LadderQueue.h"
+#include "sim/event/TournamentCalendar.h"
+#include "sim/queue/SlotRotatingPolicy.h"
+#include "sim/simulator/BasicSimulator.h"
+#include "sim/utils/ConstantDistribution.h"
+#include "sim/utils/ExponentialDistribution.h"
+
+namespace {
+
+template <class Kernel>
+std::unique_ptr<ISimulator> create_kernel(const SimulationConfig& config) {
+  return std::make_unique<Kernel>(config);
+}
 
-Simulator::Simulator(const SimulationConfig& config)
-    : config_(config), buffer_(config.buffer_capacity) {
-  if (!ConfigurationManager::validate(config)) {
-    throw std::invalid_argument("Invalid simulation configuration");
+template <class Calendar, class ArrivalDist, bool Headless>
+using DefaultKernel =
+    BasicSimulator<Calendar, SlotRotatingPolicy, RoundRobinStrategy,
+                   ArrivalDist, ExponentialDistribution, Headless>;
+
+template <bool Headless>
+using DynamicKernel =
+    BasicSimulator<IEventCalendar, IBufferPolicy, IDeviceSelectionStrategy,
+                   IDistribution, IDistribution, Headless>;
+
+template <class ArrivalDist, bool Headless>
+auto select_calendar(const SimulationConfig& config) {
+  switch (config.calendar_type) {
+    case CalendarType::CalendarQueue:
+      return &create_kernel<
+          DefaultKernel<CalendarQueue, ArrivalDist, Headless>>;
+    case CalendarType::LadderQueue:
+      return &create_kernel<DefaultKernel<LadderQueue, ArrivalDist, Headless>>;
+    case CalendarType::Tournament:
+      return &create_kernel<
+          DefaultKernel<TournamentCalendar, ArrivalDist, Headless>>;
+    case CalendarType::BinaryHeap:
+    default:
+      return &create_kernel<
+          DefaultKernel<BinaryHeapCalendar, ArrivalDist, Headless>>;
   }
+}
 
-  // Create core components
-  device_pool_ = ConfigurationManager::create_device_pool(config);
-  source_pool_ = ConfigurationManager::create_source_pool(config);
+bool all_sources(const SimulationConfig& config, DistributionType type) {
+  for (const auto& source : config.sources) {
+    if (source.arrival_distribution_type != type) return false;
+  }
+  return true;
+}
 
-  dispatcher_ = std::make_unique<EventDispatcher>(
-      *source_pool_, *device_pool_, buffer_, calendar_,
-      metrics_, config_, observers_);
+bool all_devices(const SimulationConfig& config, DistributionType type) {
+  for (const auto& device : config.devices) {
+    if (device.service_distribution_type != type) return false;
+  }
+  return true;
+}
 
-  // Initialize simulation state
-  current_time_ = 0.0;
+template <bool Headless>
+auto select_components(const SimulationConfig& config) {
+  // Default buffer discipline and device selection with exponential service
+  // times, for each calendar and either arrival distribution
+  if (config.buffer_discipline == BufferDiscipline::SlotRotating &&
+      config.device_selection == DeviceSelection::RoundRobin &&
+      all_devices(config, DistributionType::Exponential)) {
+    if (all_sources(config, DistributionType::Exponential)) {
+      return select_calendar<ExponentialDistribution, Headless>(config);
+    }
+    if (all_sources(config, DistributionType::Constant)) {
+      return select_calendar<ConstantDistribution, Headless>(config);
+    }
+  }
+  return &create_kernel<DynamicKernel<Headless>>;
+}
 
-  // Create and add MetricsObserver
-  auto metrics_observer = std::make_unique<MetricsObserver>(metrics_);
-  observers_.push_back(std::move(metrics_observer));
+}  // namespace
 
-  // Schedule initial arrivals for all sources
-  for (auto& source : source_pool_->get_all_sources()) {
-    double next_time = source->schedule_next_arrival(0.0);
-    Event arrival_event(next_time, EventType::arrival,
-                       std::weak_ptr<Request>(), nullptr, source->get_id());
-    calendar_.schedule(arrival_event);
-  }
+Simulator::KernelFactory Simulator::select_kernel(
+    const SimulationConfig& config) {
+  return config.headless ? select_components<true>(config)
+                         : select_components<false>(config);
 }
 
-bool Simulator::process_next_event() {
-  if (calendar_.is_empty()) {
-    return false;
-  }
+Simulator::Simulator(const SimulationConfig& config)
+    : kernel_factory_(select_kernel(config)),
+      kernel_(kernel_factory_(config)) {}
 
-  Event event = calendar_.pop_next();
-  current_time_ = event.get_time();
+void Simulator::reset(uint32_t seed) { kernel_->reset(seed); }
 
-  if (current_time_ > config_.max_time) {
-    return false;
+void Simulator::reconfigure(const SimulationConfig& config) {
+  KernelFactory factory = select_kernel(config);
+  if (factory == kernel_factory_) {
+    kernel_->reconfigure(config);
+    return;
   }
 
-  switch (event.get_type()) {
-    case EventType::arrival:
-      dispatcher_->handle_arrival(event.get_source_id(), current_time_);
-      break;
-    case EventType::service_end: {
-      Device* device = event.get_device();
-      if (device) {
-        dispatcher_->handle_service_end(device, current_time_);
-      }
-      break;
+  // Another instantiation: start a fresh kernel and move the observers over
+  auto kernel = factory(config);
+  auto observers = kernel_->release_observers();
+  if (config.headless && !observers.empty()) {
+    for (auto& observer : observers) {
+      kernel_->add_observer(std::move(observer));
     }
+    throw std::logic_error("Headless simulators take no observers");
   }
-
-  return true;
-}
-
-void Simulator::run() {
-  while (!is_finished()) {
-    process_next_event();
+  for (auto& observer : observers) {
+    kernel->add_observer(std::move(observer));
   }
+  kernel_ = std::move(kernel);
+  kernel_factory_ = factory;
 }
 
-void Simulator::step() { process_next_event(); }
-
 void Simulator::add_observer(std::unique_ptr<ISimulationObserver> observer) {
-  observers_.push_back(std::move(observer));
+  kernel_->add_observer(std::move(observer));
 }
 
 std::vector<bool> Simulator::get_device_states() const {
-  return device_pool_->get_device_states();
+  return kernel_->get_device_states();
 }
 
 std::vector<double> Simulator::get_source_next_event_times() const {
-  return source_pool_->get_all_next_event_times();
+  return kernel_->get_source_next_event_times();
 }
 
 std::vector<double> Simulator::get_device_next_event_times() const {
-  return device_pool_->get_all_next_event_times();
+  return kernel_->get_device_next_event_times();
 }
 
 std::vector<bool> Simulator::get_source_states() const {
-  return source_pool_->get_source_states();
-}
-
-bool Simulator::is_finished() const {
-  // Check if max time exceeded
-  if (current_time_ > config_.max_time) {
-    return true;
-  }
-
-  // Check if max arrivals reached
-  bool max_arrivals_reached = metrics_.get_arrived() >= config_.max_arrivals;
-
-  if (!max_arrivals_reached) {
-    return false;  // Still generating arrivals
-  }
-
-  // Max arrivals reached - check if system is empty
-  // System is finished when:
-  // 1. Calendar is empty (no future events)
-  // 2. Buffer is empty (no waiting requests)
-  // 3. All devices are free (no requests being serviced)
-  if (!calendar_.is_empty()) {
-    return false;  // Still have events to process
-  }
-
-  if (!buffer_.is_empty()) {
-    return false;  // Still have requests in buffer
-  }
-
-  // Check if all devices are free
-  const auto& devices = device_pool_->get_all_devices();
-  for (const auto& device : devices) {
-    if (device && !device->is_free()) {
-      return false;  // Still have requests being serviced
-    }
-  }
-
-  // All conditions met - simulation finished
-  return true;
+  return kernel_->get_source_states();
 }
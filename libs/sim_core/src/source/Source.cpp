@@ -5,12 +5,6 @@ Source::Source(size_t id, std::unique_ptr<IDistribution> distribution)
       arrival_distribution_(std::move(distribution)),
       next_arrival_time_(NO_EVENT_TIME) {}
 
-double Source::schedule_next_arrival(double current_time) {
-  double interval = arrival_distribution_->generate();
-  next_arrival_time_ = current_time + interval;
-  return next_arrival_time_;
-}
-
 double Source::get_next_arrival_time() const {
   return next_arrival_time_;
 }
@@ -27,3 +21,15 @@ void Source::clear_next_arrival_time() {
   next_arrival_time_ = NO_EVENT_TIME;
 }
 
+IDistribution& Source::get_distribution() { return *arrival_distribution_; }
+
+void Source::set_distribution(std::unique_ptr<IDistribution> distribution) {
+  arrival_distribution_ = std::move(distribution);
+  variates_.clear();
+}
+
+void Source::reset() {
+  next_arrival_time_ = NO_EVENT_TIME;
+  variates_.clear();
+}
+
@@ -54,3 +54,17 @@ size_t SourcePool::size() const {
   return sources_.size();
 }
 
+void SourcePool::truncate(size_t count) {
+  if (count < sources_.size()) {
+    sources_.resize(count);
+  }
+}
+
+void SourcePool::reset() {
+  for (auto& source : sources_) {
+    if (source) {
+      source->reset();
+    }
+  }
+}
+
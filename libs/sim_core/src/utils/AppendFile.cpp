@@ -0,0 +1,138 @@
+#include "sim/utils/AppendFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+AppendFile::AppendFile(const std::string& path)
+    : path_(path),
+      buffer_(new std::byte[BUFFER_BYTES]),
+      capacity_(BUFFER_BYTES),
+      used_(0),
+      size_(0),
+      file_(nullptr) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr,
+                            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot create " + path);
+  }
+  file_ = file;
+}
+
+bool AppendFile::write(const std::byte* data, size_t length) {
+  while (length > 0) {
+    auto part = static_cast<DWORD>(std::min<size_t>(length, 1u << 30));
+    DWORD written = 0;
+    if (!WriteFile(file_, data, part, &written, nullptr) || written == 0) {
+      return false;
+    }
+    data += written;
+    length -= written;
+  }
+  return true;
+}
+
+void AppendFile::close_file() {
+  CloseHandle(file_);
+  file_ = nullptr;
+}
+
+#else
+
+AppendFile::AppendFile(const std::string& path)
+    : path_(path),
+      buffer_(new std::byte[BUFFER_BYTES]),
+      capacity_(BUFFER_BYTES),
+      used_(0),
+      size_(0),
+      file_(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+  if (file_ < 0) {
+    throw std::runtime_error("Cannot create " + path);
+  }
+}
+
+bool AppendFile::write(const std::byte* data, size_t length) {
+  while (length > 0) {
+    ssize_t written = ::write(file_, data, length);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+void AppendFile::close_file() {
+  ::close(file_);
+  file_ = -1;
+}
+
+#endif  // _WIN32
+
+AppendFile::~AppendFile() {
+  try {
+    close();
+  } catch (const std::runtime_error&) {
+  }
+}
+
+std::byte* AppendFile::reserve(size_t length) {
+  if (used_ + length <= capacity_) {
+    return buffer_.get() + used_;
+  }
+  if (buffer_ == nullptr) {
+    throw std::logic_error("Writing to closed file " + path_);
+  }
+  flush();
+  if (length > capacity_) {
+    buffer_.reset(new std::byte[length]);
+    capacity_ = length;
+  }
+  return buffer_.get();
+}
+
+void AppendFile::append(const void* data, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  std::memcpy(reserve(length), data, length);
+  commit(length);
+}
+
+void AppendFile::flush() {
+  if (!write(buffer_.get(), used_)) {
+    throw std::runtime_error("Cannot write " + path_);
+  }
+  used_ = 0;
+}
+
+void AppendFile::close() {
+  if (buffer_ == nullptr) {
+    return;
+  }
+  bool written = write(buffer_.get(), used_);
+  close_file();
+  buffer_.reset();
+  capacity_ = 0;
+  used_ = 0;
+  if (!written) {
+    throw std::runtime_error("Cannot write " + path_);
+  }
+}
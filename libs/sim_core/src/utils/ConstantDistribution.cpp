@@ -1,7 +1,17 @@
 #include "sim/utils/ConstantDistribution.h"
 
+#include <algorithm>
+
 ConstantDistribution::ConstantDistribution(double constant_value)
     : constant_value_(constant_value) {}
 
 double ConstantDistribution::generate() { return constant_value_; }
 
+void ConstantDistribution::fill(std::span<double> values) {
+  std::fill(values.begin(), values.end(), constant_value_);
+}
+
+void ConstantDistribution::set_parameter(double param) {
+  constant_value_ = param;
+}
+
@@ -0,0 +1,50 @@
+#include "sim/utils/EmpiricalDistribution.h"
+
+#include <algorithm>
+
+EmpiricalDistribution::EmpiricalDistribution(
+    double intensity, const std::string& histogram_path,
+    std::shared_ptr<const Histogram> histogram,
+    std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      histogram_path_(histogram_path),
+      histogram_(std::move(histogram)) {
+  set_parameter(intensity);
+}
+
+double EmpiricalDistribution::generate() { return sample(); }
+
+// Takes the same words as generate() but looks up a batch at a time, so
+// the cache misses into a large table overlap instead of queueing up
+void EmpiricalDistribution::fill(std::span<double> values) {
+  constexpr size_t BATCH = BitBlock::SIZE / 2;
+  uint64_t bin_bits[BATCH];
+  uint64_t position_bits[BATCH];
+  size_t bins[BATCH];
+
+  for (size_t start = 0; start < values.size(); start += BATCH) {
+    size_t count = std::min(BATCH, values.size() - start);
+    for (size_t i = 0; i < count; ++i) {
+      bin_bits[i] = bits_.next(*engine_);
+      position_bits[i] = bits_.next(*engine_);
+      histogram_->prefetch(histogram_->get_column(bin_bits[i]));
+    }
+    for (size_t i = 0; i < count; ++i) {
+      bins[i] = histogram_->get_bin(bin_bits[i]);
+      histogram_->prefetch(bins[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      values[start + i] =
+          histogram_->get_value(bins[i], position_bits[i]) * scale_;
+    }
+  }
+}
+
+void EmpiricalDistribution::set_parameter(double param) {
+  scale_ = 1.0 / (param * histogram_->get_mean());
+}
+
+void EmpiricalDistribution::reseed(const StreamId& stream) {
+  RandomDistribution::reseed(stream);
+  bits_.clear();
+}
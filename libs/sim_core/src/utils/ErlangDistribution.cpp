@@ -0,0 +1,39 @@
+#include "sim/utils/ErlangDistribution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "sim/utils/Ziggurat.h"
+
+ErlangDistribution::ErlangDistribution(double intensity, double shape,
+                                       std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)), mean_(1.0 / intensity) {
+  set_shape(shape);
+}
+
+double ErlangDistribution::generate() { return sample(); }
+
+void ErlangDistribution::fill(std::span<double> values) {
+  for (double& value : values) {
+    value = sample();
+  }
+}
+
+void ErlangDistribution::set_parameter(double param) { mean_ = 1.0 / param; }
+
+void ErlangDistribution::set_shape(double shape) {
+  stages_ = static_cast<size_t>(std::max(1.0, std::round(shape)));
+}
+
+void ErlangDistribution::reseed(const StreamId& stream) {
+  RandomDistribution::reseed(stream);
+  bits_.clear();
+}
+
+double ErlangDistribution::sample() {
+  double sum = 0.0;
+  for (size_t i = 0; i < stages_; ++i) {
+    sum += Ziggurat::exponential(bits_, *engine_);
+  }
+  return sum * mean_ / static_cast<double>(stages_);
+}
@@ -0,0 +1,210 @@
+#include "sim/utils/EventTraceReader.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+EventTraceReader::EventTraceReader(const std::string& path)
+    : file_(path), path_(path), record_count_(0), complete_(false) {
+  if (file_.get_size() < sizeof(EventTrace::MAGIC) ||
+      std::memcmp(file_.get_data(), EventTrace::MAGIC,
+                  sizeof(EventTrace::MAGIC)) != 0) {
+    throw std::invalid_argument("Not an event trace: " + path);
+  }
+  complete_ = read_index();
+  if (!complete_) {
+    scan_chunks();
+  }
+}
+
+EventTraceReader::Cursor EventTraceReader::seek(uint64_t record) const {
+  if (record >= record_count_) {
+    return Cursor(*this, index_.size());
+  }
+  auto after = std::upper_bound(
+      index_.begin(), index_.end(), record,
+      [](uint64_t value, const EventTrace::IndexEntry& entry) {
+        return value < entry.first_record;
+      });
+  Cursor cursor(*this, static_cast<size_t>(after - index_.begin()) - 1);
+  TraceRecord skipped;
+  while (cursor.get_position() < record && cursor.next(skipped)) {
+  }
+  return cursor;
+}
+
+// Chunks before the last one starting earlier than time hold only earlier
+// records
+EventTraceReader::Cursor EventTraceReader::seek_time(double time) const {
+  auto after = std::lower_bound(
+      index_.begin(), index_.end(), time,
+      [](const EventTrace::IndexEntry& entry, double value) {
+        return entry.first_time < value;
+      });
+  size_t chunk = after == index_.begin()
+                     ? 0
+                     : static_cast<size_t>(after - index_.begin()) - 1;
+  Cursor cursor(*this, chunk);
+  TraceRecord record;
+  for (Cursor probe = cursor; probe.next(record) && record.time < time;) {
+    cursor = probe;
+  }
+  return cursor;
+}
+
+bool EventTraceReader::read_index() {
+  const std::byte* data = file_.get_data();
+  size_t size = file_.get_size();
+  EventTrace::Trailer trailer;
+  if (size < sizeof(EventTrace::MAGIC) + sizeof(trailer)) {
+    return false;
+  }
+  std::memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+  if (std::memcmp(trailer.magic, EventTrace::INDEX_MAGIC,
+                  sizeof(trailer.magic)) != 0) {
+    return false;
+  }
+
+  size_t index_end = size - sizeof(trailer);
+  if (trailer.index_offset < sizeof(EventTrace::MAGIC) ||
+      trailer.index_offset > index_end ||
+      (index_end - trailer.index_offset) / sizeof(EventTrace::IndexEntry) !=
+          trailer.chunk_count ||
+      (index_end - trailer.index_offset) % sizeof(EventTrace::IndexEntry) !=
+          0) {
+    throw std::invalid_argument("Corrupt event trace index: " + path_);
+  }
+  index_.resize(static_cast<size_t>(trailer.chunk_count));
+  if (!index_.empty()) {
+    std::memcpy(index_.data(), data + trailer.index_offset,
+                index_.size() * sizeof(EventTrace::IndexEntry));
+  }
+  for (const auto& entry : index_) {
+    if (entry.offset + sizeof(EventTrace::ChunkHeader) >
+        trailer.index_offset) {
+      throw std::invalid_argument("Corrupt event trace index: " + path_);
+    }
+  }
+  record_count_ = trailer.record_count;
+  return true;
+}
+
+// Follows the chunk headers up to the first incomplete one
+void EventTraceReader::scan_chunks() {
+  const std::byte* data = file_.get_data();
+  size_t size = file_.get_size();
+  size_t offset = sizeof(EventTrace::MAGIC);
+  EventTrace::ChunkHeader header;
+  while (size - offset >= sizeof(header)) {
+    std::memcpy(&header, data + offset, sizeof(header));
+    if (header.record_count == 0 ||
+        header.record_count > EventTrace::CHUNK_RECORDS ||
+        header.payload_bytes > size - offset - sizeof(header) ||
+        header.first_record != record_count_) {
+      break;
+    }
+    index_.push_back({header.first_time, offset, record_count_});
+    record_count_ += header.record_count;
+    offset += sizeof(header) + header.payload_bytes;
+  }
+}
+
+EventTrace::ChunkHeader EventTraceReader::get_chunk_header(
+    size_t chunk) const {
+  EventTrace::ChunkHeader header;
+  std::memcpy(&header, file_.get_data() + index_[chunk].offset,
+              sizeof(header));
+  return header;
+}
+
+EventTraceReader::Cursor::Cursor(const EventTraceReader& reader, size_t chunk)
+    : reader_(&reader) {
+  load_chunk(chunk);
+}
+
+bool EventTraceReader::Cursor::next(TraceRecord& record) {
+  while (chunk_remaining_ == 0) {
+    if (!load_chunk(chunk_ + 1)) {
+      return false;
+    }
+  }
+
+  unsigned tag = read_tag();
+  auto kind = static_cast<EventKind>(tag & 7);
+  if (kind > EventKind::Refusal) {
+    throw std::invalid_argument("Corrupt record in event trace: " +
+                                reader_->path_);
+  }
+  time_bits_ += read_field(tag >> 3);
+  tag = read_tag();
+  request_id_ += EventTrace::unzigzag(read_field(tag & 15));
+  record.kind = kind;
+  record.time = std::bit_cast<double>(time_bits_);
+  record.request_id = static_cast<size_t>(request_id_);
+  record.source_id = static_cast<size_t>(read_field(tag >> 4));
+  record.device_id = 0;
+  record.buffer_slot = 0;
+  if (EventTrace::has_device(kind) || EventTrace::has_buffer_slot(kind)) {
+    tag = read_tag();
+    record.device_id = static_cast<size_t>(read_field(tag & 15));
+    record.buffer_slot = static_cast<size_t>(read_field(tag >> 4));
+  }
+  --chunk_remaining_;
+  ++position_;
+  return true;
+}
+
+bool EventTraceReader::Cursor::load_chunk(size_t chunk) {
+  chunk_ = chunk;
+  if (chunk >= reader_->index_.size()) {
+    in_ = nullptr;
+    end_ = nullptr;
+    limit_ = nullptr;
+    chunk_remaining_ = 0;
+    position_ = reader_->record_count_;
+    return false;
+  }
+
+  EventTrace::ChunkHeader header = reader_->get_chunk_header(chunk);
+  size_t payload = reader_->index_[chunk].offset + sizeof(header);
+  if (header.payload_bytes > reader_->file_.get_size() - payload) {
+    throw std::invalid_argument("Corrupt chunk in event trace: " +
+                                reader_->path_);
+  }
+  in_ = reader_->file_.get_data() + payload;
+  end_ = in_ + header.payload_bytes;
+  limit_ = reader_->file_.get_data() + reader_->file_.get_size();
+  chunk_remaining_ = header.record_count;
+  position_ = header.first_record;
+  time_bits_ = std::bit_cast<uint64_t>(header.first_time);
+  request_id_ = header.first_request_id;
+  return true;
+}
+
+unsigned EventTraceReader::Cursor::read_tag() {
+  if (in_ == end_) {
+    throw std::invalid_argument("Corrupt record in event trace: " +
+                                reader_->path_);
+  }
+  return static_cast<unsigned>(*in_++);
+}
+
+uint64_t EventTraceReader::Cursor::read_field(unsigned length) {
+  if (length > sizeof(uint64_t) ||
+      length > static_cast<size_t>(end_ - in_)) {
+    throw std::invalid_argument("Corrupt record in event trace: " +
+                                reader_->path_);
+  }
+  uint64_t value;
+  // Only the end of a trace cut short leaves less than a word to read
+  if (limit_ - in_ >= static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+    value = EventTrace::get_field(in_, length);
+  } else {
+    std::byte word[sizeof(uint64_t)] = {};
+    std::memcpy(word, in_, length);
+    value = EventTrace::get_field(word, length);
+  }
+  in_ += length;
+  return value;
+}
@@ -1,7 +1,22 @@
 #include "sim/utils/ExponentialDistribution.h"
 
-ExponentialDistribution::ExponentialDistribution(double intensity, uint32_t seed)
-    : rng_(seed), dist_(intensity) {}
+#include "sim/utils/VectorMath.h"
 
-double ExponentialDistribution::generate() { return dist_(rng_); }
+ExponentialDistribution::ExponentialDistribution(
+    double intensity, std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)), mean_(1.0 / intensity) {}
 
+double ExponentialDistribution::generate() {
+  double value = engine_->next_uniform();
+  VectorMath::log_scaled(std::span<double>(&value, 1), -mean_);
+  return value;
+}
+
+void ExponentialDistribution::fill(std::span<double> values) {
+  engine_->fill_uniform(values);
+  VectorMath::log_scaled(values, -mean_);
+}
+
+void ExponentialDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+}
@@ -0,0 +1,213 @@
+#include "sim/utils/Histogram.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+constexpr char BINARY_MAGIC[8] = {'S', 'I', 'M', 'H', 'I', 'S', 'T', '1'};
+
+std::string read_file(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open histogram file " + path);
+  }
+  file.seekg(0, std::ios::end);
+  std::string contents(static_cast<size_t>(file.tellg()), '\0');
+  file.seekg(0, std::ios::beg);
+  file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+  if (!file) {
+    throw std::runtime_error("Cannot read histogram file " + path);
+  }
+  return contents;
+}
+
+bool is_separator(char c) {
+  return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parses exactly three numbers separated by separators
+bool parse_bin(std::string_view line, double (&fields)[3]) {
+  const char* position = line.data();
+  const char* end = line.data() + line.size();
+  for (double& field : fields) {
+    while (position != end && is_separator(*position)) {
+      ++position;
+    }
+    auto result = std::from_chars(position, end, field);
+    if (result.ec != std::errc()) {
+      return false;
+    }
+    position = result.ptr;
+  }
+  while (position != end && is_separator(*position)) {
+    ++position;
+  }
+  return position == end;
+}
+
+void parse_text(const std::string& path, std::string_view contents,
+                std::vector<double>& lower, std::vector<double>& upper,
+                std::vector<double>& weights) {
+  size_t line_number = 0;
+  bool header_allowed = true;
+  while (!contents.empty()) {
+    size_t newline = contents.find('\n');
+    std::string_view line = contents.substr(0, newline);
+    contents.remove_prefix(newline == std::string_view::npos ? contents.size()
+                                                            : newline + 1);
+    ++line_number;
+
+    line = line.substr(0, line.find('#'));
+    if (line.find_first_not_of(", ;\t\r") == std::string_view::npos) {
+      continue;
+    }
+
+    double fields[3];
+    if (!parse_bin(line, fields)) {
+      if (header_allowed) {
+        header_allowed = false;
+        continue;
+      }
+      throw std::invalid_argument("Histogram " + path + " line " +
+                                  std::to_string(line_number) +
+                                  ": expected lower,upper,weight");
+    }
+    header_allowed = false;
+    lower.push_back(fields[0]);
+    upper.push_back(fields[1]);
+    weights.push_back(fields[2]);
+  }
+}
+
+void parse_binary(const std::string& path, std::string_view contents,
+                  std::vector<double>& lower, std::vector<double>& upper,
+                  std::vector<double>& weights) {
+  uint64_t count = 0;
+  if (contents.size() >= sizeof(BINARY_MAGIC) + sizeof(count)) {
+    std::memcpy(&count, contents.data() + sizeof(BINARY_MAGIC), sizeof(count));
+  }
+  size_t header = sizeof(BINARY_MAGIC) + sizeof(count);
+  if (contents.size() < header ||
+      count != (contents.size() - header) / (3 * sizeof(double)) ||
+      (contents.size() - header) % (3 * sizeof(double)) != 0) {
+    throw std::invalid_argument("Histogram " + path +
+                                ": size does not match the bin count");
+  }
+
+  lower.resize(count);
+  upper.resize(count);
+  weights.resize(count);
+  const char* bin = contents.data() + header;
+  for (size_t i = 0; i < count; ++i, bin += 3 * sizeof(double)) {
+    std::memcpy(&lower[i], bin, sizeof(double));
+    std::memcpy(&upper[i], bin + sizeof(double), sizeof(double));
+    std::memcpy(&weights[i], bin + 2 * sizeof(double), sizeof(double));
+  }
+}
+
+}  // namespace
+
+Histogram::Histogram(const std::vector<double>& lower,
+                     const std::vector<double>& upper,
+                     const std::vector<double>& weights) {
+  size_t count = lower.size();
+  if (count == 0 || upper.size() != count || weights.size() != count) {
+    throw std::invalid_argument("Histogram needs matching, non-empty bins");
+  }
+  if (count > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("Histogram has too many bins");
+  }
+
+  double total = 0.0;
+  double moment = 0.0;
+  bins_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    bool valid = std::isfinite(lower[i]) && std::isfinite(upper[i]) &&
+                 std::isfinite(weights[i]) && lower[i] >= 0.0 &&
+                 lower[i] <= upper[i] && weights[i] >= 0.0;
+    if (!valid) {
+      throw std::invalid_argument("Histogram bin " + std::to_string(i) +
+                                  " is not a valid [lower, upper), weight");
+    }
+    bins_[i].lower = lower[i];
+    bins_[i].width = upper[i] - lower[i];
+    total += weights[i];
+    moment += weights[i] * 0.5 * (lower[i] + upper[i]);
+  }
+  if (!(total > 0.0) || !(moment > 0.0) || !std::isfinite(moment)) {
+    throw std::invalid_argument(
+        "Histogram needs a positive total weight and mean");
+  }
+  mean_ = moment / total;
+
+  build_alias_table(weights);
+}
+
+// Vose: bins below the average probability are topped up from one above
+// it, which then carries on with what is left, so each bin ends up holding
+// its own mass plus at most one alias
+void Histogram::build_alias_table(const std::vector<double>& weights) {
+  size_t count = weights.size();
+  double total = 0.0;
+  for (double weight : weights) {
+    total += weight;
+  }
+
+  std::vector<double> probability(count);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (size_t i = 0; i < count; ++i) {
+    probability[i] = weights[i] / total * static_cast<double>(count);
+    bins_[i].alias = static_cast<uint32_t>(i);
+    (probability[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t under = small.back();
+    small.pop_back();
+    uint32_t over = large.back();
+    bins_[under].alias = over;
+    bins_[under].threshold = static_cast<uint32_t>(
+        std::min(std::round(probability[under] * 0x1.0p32), 0x1.0p32 - 1.0));
+    probability[over] -= 1.0 - probability[under];
+    if (probability[over] < 1.0) {
+      large.pop_back();
+      small.push_back(over);
+    }
+  }
+  // What remains is full up to rounding and never takes its alias
+  for (uint32_t i : small) {
+    bins_[i].alias = i;
+    bins_[i].threshold = std::numeric_limits<uint32_t>::max();
+  }
+  for (uint32_t i : large) {
+    bins_[i].alias = i;
+    bins_[i].threshold = std::numeric_limits<uint32_t>::max();
+  }
+}
+
+Histogram Histogram::read(const std::string& path) {
+  std::string contents = read_file(path);
+  std::vector<double> lower;
+  std::vector<double> upper;
+  std::vector<double> weights;
+  if (contents.compare(0, sizeof(BINARY_MAGIC),
+                       std::string_view(BINARY_MAGIC, sizeof(BINARY_MAGIC))) ==
+      0) {
+    parse_binary(path, contents, lower, upper, weights);
+  } else {
+    parse_text(path, contents, lower, upper, weights);
+  }
+  return Histogram(lower, upper, weights);
+}
+
+size_t Histogram::get_memory_bytes() const {
+  return bins_.capacity() * sizeof(Bin);
+}
@@ -0,0 +1,17 @@
+#include "sim/utils/HistogramCache.h"
+
+std::shared_ptr<const Histogram> HistogramCache::load(const std::string& path) {
+  auto it = histograms_.find(path);
+  if (it != histograms_.end()) {
+    return it->second;
+  }
+  auto histogram = std::make_shared<const Histogram>(Histogram::read(path));
+  histograms_.emplace(path, histogram);
+  return histogram;
+}
+
+void HistogramCache::release_unused() {
+  std::erase_if(histograms_, [](const auto& entry) {
+    return entry.second.use_count() == 1;
+  });
+}
@@ -0,0 +1,50 @@
+#include "sim/utils/HyperexponentialDistribution.h"
+
+#include <cmath>
+
+#include "sim/utils/Ziggurat.h"
+
+HyperexponentialDistribution::HyperexponentialDistribution(
+    double intensity, double shape, std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      scv_(shape) {
+  update();
+}
+
+double HyperexponentialDistribution::generate() { return sample(); }
+
+void HyperexponentialDistribution::fill(std::span<double> values) {
+  for (double& value : values) {
+    value = sample();
+  }
+}
+
+void HyperexponentialDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void HyperexponentialDistribution::set_shape(double shape) {
+  scv_ = shape;
+  update();
+}
+
+void HyperexponentialDistribution::reseed(const StreamId& stream) {
+  RandomDistribution::reseed(stream);
+  bits_.clear();
+}
+
+// Balanced means: p1 / mu1 = p2 / mu2, which fixes both branches from the
+// mean and the squared coefficient of variation
+void HyperexponentialDistribution::update() {
+  first_probability_ = 0.5 * (1.0 + std::sqrt((scv_ - 1.0) / (scv_ + 1.0)));
+  first_mean_ = mean_ / (2.0 * first_probability_);
+  second_mean_ = mean_ / (2.0 * (1.0 - first_probability_));
+}
+
+double HyperexponentialDistribution::sample() {
+  double branch = bits_.next_uniform(*engine_);
+  double mean = branch <= first_probability_ ? first_mean_ : second_mean_;
+  return Ziggurat::exponential(bits_, *engine_) * mean;
+}
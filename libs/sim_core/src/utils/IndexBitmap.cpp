@@ -0,0 +1,141 @@
+#include "sim/utils/IndexBitmap.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+constexpr size_t WORD_BITS = 64;
+constexpr uint64_t ALL_ONES = ~uint64_t{0};
+
+size_t word_count(size_t bits) { return (bits + WORD_BITS - 1) / WORD_BITS; }
+
+// Bits at positions >= offset within a word
+uint64_t mask_from(size_t offset) { return ALL_ONES << offset; }
+
+// Bits at positions <= offset within a word
+uint64_t mask_upto(size_t offset) {
+  return ALL_ONES >> (WORD_BITS - 1 - offset);
+}
+
+size_t highest_bit(uint64_t word) {
+  return WORD_BITS - 1 - static_cast<size_t>(std::countl_zero(word));
+}
+
+size_t lowest_bit(uint64_t word) {
+  return static_cast<size_t>(std::countr_zero(word));
+}
+
+}  // namespace
+
+IndexBitmap::IndexBitmap(size_t size, bool value) : size_(0) {
+  assign(size, value);
+}
+
+void IndexBitmap::assign(size_t size, bool value) {
+  size_ = size;
+  // Level 0 has one bit per index; every level above summarizes the words
+  // of the level below, up to a single root word
+  size_t level_count = 0;
+  size_t bits = size_;
+  do {
+    size_t words = word_count(bits);
+    if (level_count == levels_.size()) {
+      levels_.emplace_back();
+    }
+    auto& level = levels_[level_count];
+    level.assign(words, value ? ALL_ONES : 0);
+    if (value && bits % WORD_BITS != 0) {
+      level.back() = mask_upto(bits % WORD_BITS - 1);
+    }
+    ++level_count;
+    bits = words;
+  } while (bits > 1);
+  levels_.resize(level_count);
+}
+
+void IndexBitmap::set(size_t index) {
+  for (auto& level : levels_) {
+    uint64_t& word = level[index / WORD_BITS];
+    bool was_empty = word == 0;
+    word |= uint64_t{1} << (index % WORD_BITS);
+    if (!was_empty) {
+      return;
+    }
+    index /= WORD_BITS;
+  }
+}
+
+void IndexBitmap::reset(size_t index) {
+  for (auto& level : levels_) {
+    uint64_t& word = level[index / WORD_BITS];
+    word &= ~(uint64_t{1} << (index % WORD_BITS));
+    if (word != 0) {
+      return;
+    }
+    index /= WORD_BITS;
+  }
+}
+
+bool IndexBitmap::test(size_t index) const {
+  return (levels_[0][index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+size_t IndexBitmap::find_next(size_t from) const {
+  if (from >= size_) {
+    return NPOS;
+  }
+
+  // Climb until a word holds a member at or after the position, then
+  // descend through the first non-empty word of every level below
+  size_t level = 0;
+  size_t pos = from;
+  while (true) {
+    size_t word = pos / WORD_BITS;
+    if (word >= levels_[level].size()) {
+      return NPOS;
+    }
+    uint64_t bits = levels_[level][word] & mask_from(pos % WORD_BITS);
+    if (bits != 0) {
+      pos = word * WORD_BITS + lowest_bit(bits);
+      break;
+    }
+    if (++level == levels_.size()) {
+      return NPOS;
+    }
+    pos = word + 1;
+  }
+  while (level > 0) {
+    --level;
+    pos = pos * WORD_BITS + lowest_bit(levels_[level][pos]);
+  }
+  return pos;
+}
+
+size_t IndexBitmap::find_prev(size_t from) const {
+  if (size_ == 0) {
+    return NPOS;
+  }
+
+  size_t level = 0;
+  size_t pos = std::min(from, size_ - 1);
+  while (true) {
+    size_t word = pos / WORD_BITS;
+    uint64_t bits = levels_[level][word] & mask_upto(pos % WORD_BITS);
+    if (bits != 0) {
+      pos = word * WORD_BITS + highest_bit(bits);
+      break;
+    }
+    if (word == 0 || ++level == levels_.size()) {
+      return NPOS;
+    }
+    pos = word - 1;
+  }
+  while (level > 0) {
+    --level;
+    pos = pos * WORD_BITS + highest_bit(levels_[level][pos]);
+  }
+  return pos;
+}
+
+size_t IndexBitmap::size() const { return size_; }
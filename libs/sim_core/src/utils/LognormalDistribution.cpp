@@ -0,0 +1,44 @@
+#include "sim/utils/LognormalDistribution.h"
+
+#include <cmath>
+
+#include "sim/utils/Ziggurat.h"
+
+LognormalDistribution::LognormalDistribution(
+    double intensity, double shape, std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      sigma_(shape) {
+  update();
+}
+
+double LognormalDistribution::generate() {
+  return std::exp(mu_ + sigma_ * Ziggurat::normal(bits_, *engine_));
+}
+
+void LognormalDistribution::fill(std::span<double> values) {
+  Ziggurat::fill_normal(values, bits_, *engine_);
+  for (double& value : values) {
+    value = std::exp(mu_ + sigma_ * value);
+  }
+}
+
+void LognormalDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void LognormalDistribution::set_shape(double shape) {
+  sigma_ = shape;
+  update();
+}
+
+void LognormalDistribution::reseed(const StreamId& stream) {
+  RandomDistribution::reseed(stream);
+  bits_.clear();
+}
+
+// E[exp(mu + sigma Z)] = exp(mu + sigma^2 / 2)
+void LognormalDistribution::update() {
+  mu_ = std::log(mean_) - 0.5 * sigma_ * sigma_;
+}
@@ -0,0 +1,139 @@
+#include "sim/utils/MappedFile.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+    : data_(nullptr), size_(0), file_(nullptr), mapping_(nullptr) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("Cannot read the size of " + path);
+  }
+  file_ = file;
+  size_ = static_cast<size_t>(size.QuadPart);
+  // Empty files cannot be mapped
+  if (size_ == 0) {
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void* view = mapping != nullptr
+                   ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                   : nullptr;
+  if (view == nullptr) {
+    if (mapping != nullptr) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    throw std::runtime_error("Cannot map " + path);
+  }
+  mapping_ = mapping;
+  data_ = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(mapping_);
+  }
+  if (file_ != nullptr) {
+    CloseHandle(file_);
+  }
+}
+
+// FILE_FLAG_SEQUENTIAL_SCAN above already asks for read-ahead
+void MappedFile::advise_sequential() const {}
+
+// Unlocking pages that are not locked takes them out of the working set
+void MappedFile::release(size_t offset, size_t length) const {
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  size_t page = info.dwPageSize;
+  size_t begin = (offset + page - 1) / page * page;
+  size_t end = std::min(offset + length, size_) / page * page;
+  if (begin < end) {
+    VirtualUnlock(const_cast<std::byte*>(data_) + begin, end - begin);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0) {
+    close(file);
+    throw std::runtime_error("Cannot read the size of " + path);
+  }
+  size_ = static_cast<size_t>(status.st_size);
+  // Empty files cannot be mapped
+  if (size_ == 0) {
+    close(file);
+    return;
+  }
+
+  void* view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping keeps the file referenced
+  close(file);
+  if (view == MAP_FAILED) {
+    throw std::runtime_error("Cannot map " + path);
+  }
+  data_ = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<std::byte*>(data_), size_);
+  }
+}
+
+void MappedFile::advise_sequential() const {
+  if (data_ != nullptr) {
+    madvise(const_cast<std::byte*>(data_), size_, MADV_SEQUENTIAL);
+  }
+}
+
+void MappedFile::release(size_t offset, size_t length) const {
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t begin = (offset + page - 1) / page * page;
+  size_t end = std::min(offset + length, size_) / page * page;
+  if (begin < end) {
+    madvise(const_cast<std::byte*>(data_) + begin, end - begin,
+            MADV_DONTNEED);
+  }
+}
+
+#endif  // _WIN32
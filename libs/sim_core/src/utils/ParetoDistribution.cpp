@@ -0,0 +1,42 @@
+#include "sim/utils/ParetoDistribution.h"
+
+#include <cmath>
+
+#include "sim/utils/VectorMath.h"
+
+ParetoDistribution::ParetoDistribution(double intensity, double shape,
+                                       std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      alpha_(shape) {
+  update();
+}
+
+double ParetoDistribution::generate() {
+  double value;
+  fill(std::span<double>(&value, 1));
+  return value;
+}
+
+void ParetoDistribution::fill(std::span<double> values) {
+  engine_->fill_uniform(values);
+  VectorMath::log_scaled(values, -1.0 / alpha_);
+  for (double& value : values) {
+    value = minimum_ * std::exp(value);
+  }
+}
+
+void ParetoDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void ParetoDistribution::set_shape(double shape) {
+  alpha_ = shape;
+  update();
+}
+
+// The mean of Pareto(x_m, alpha) is alpha * x_m / (alpha - 1)
+void ParetoDistribution::update() {
+  minimum_ = mean_ * (alpha_ - 1.0) / alpha_;
+}
@@ -0,0 +1,124 @@
+#include "sim/utils/TraceDistribution.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = {'S', 'I', 'M', 'T', 'R', 'A', 'C', '1'};
+constexpr size_t HEADER_BYTES = sizeof(TRACE_MAGIC) + 2 * sizeof(uint64_t);
+
+}  // namespace
+
+TraceDistribution::TraceDistribution(double rate, const std::string& path,
+                                     TraceColumn column, bool loop,
+                                     size_t part, size_t parts)
+    : file_(path),
+      path_(path),
+      column_(column),
+      loop_(loop),
+      part_(part),
+      parts_(parts) {
+  const std::byte* data = file_.get_data();
+  size_t size = file_.get_size();
+  uint64_t records = 0;
+  uint64_t columns = 0;
+  if (size >= HEADER_BYTES &&
+      std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0) {
+    std::memcpy(&records, data + sizeof(TRACE_MAGIC), sizeof(records));
+    std::memcpy(&columns, data + sizeof(TRACE_MAGIC) + sizeof(records),
+                sizeof(columns));
+  }
+  if (records == 0 || (columns != 1 && columns != 2) ||
+      (size - HEADER_BYTES) / sizeof(double) / columns != records ||
+      (size - HEADER_BYTES) % (columns * sizeof(double)) != 0) {
+    throw std::invalid_argument("Not a trace file: " + path);
+  }
+  if (column == TraceColumn::ServiceTimes && columns < 2) {
+    throw std::invalid_argument("Trace has no service times: " + path);
+  }
+  if (parts == 0 || part >= parts || records < parts) {
+    throw std::invalid_argument("Trace too short to split " +
+                                std::to_string(parts) + " ways: " + path);
+  }
+
+  // The mapping is page aligned and the header a multiple of 8 bytes, so
+  // the records are aligned doubles
+  stride_ = static_cast<size_t>(columns);
+  auto first = static_cast<size_t>(records * part / parts);
+  records_ = static_cast<size_t>(records * (part + 1) / parts) - first;
+  values_ = reinterpret_cast<const double*>(data + HEADER_BYTES) +
+            first * stride_ + (column == TraceColumn::ServiceTimes ? 1 : 0);
+  first_byte_ = HEADER_BYTES + first * stride_ * sizeof(double);
+  first_previous_timestamp_ = first > 0 ? *(values_ - stride_) : 0.0;
+  file_.advise_sequential();
+
+  set_parameter(rate);
+  restart();
+}
+
+double TraceDistribution::generate() {
+  double value;
+  fill(std::span<double>(&value, 1));
+  return value;
+}
+
+void TraceDistribution::fill(std::span<double> values) {
+  size_t done = 0;
+  while (done < values.size()) {
+    if (position_ == records_) {
+      if (!loop_) {
+        std::fill(values.begin() + done, values.end(),
+                  std::numeric_limits<double>::infinity());
+        return;
+      }
+      restart();
+    }
+    size_t count = std::min(values.size() - done, records_ - position_);
+    const double* record = values_ + position_ * stride_;
+    double* out = values.data() + done;
+
+    if (column_ == TraceColumn::ServiceTimes) {
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = record[i * stride_] * scale_;
+      }
+    } else {
+      // Independent differences, so the loop vectorizes
+      out[0] = std::max(record[0] - previous_timestamp_, 0.0) * scale_;
+      for (size_t i = 1; i < count; ++i) {
+        out[i] =
+            std::max(record[i * stride_] - record[(i - 1) * stride_], 0.0) *
+            scale_;
+      }
+      previous_timestamp_ = record[(count - 1) * stride_];
+    }
+
+    position_ += count;
+    done += count;
+    release_consumed();
+  }
+}
+
+void TraceDistribution::set_parameter(double param) { scale_ = 1.0 / param; }
+
+void TraceDistribution::reseed(const StreamId& /*stream*/) { restart(); }
+
+void TraceDistribution::restart() {
+  position_ = 0;
+  previous_timestamp_ = first_previous_timestamp_;
+  released_bytes_ = 0;
+}
+
+void TraceDistribution::release_consumed() {
+  size_t consumed = first_byte_ + position_ * stride_ * sizeof(double);
+  if (consumed - released_bytes_ < RELEASE_CHUNK) {
+    return;
+  }
+  size_t release_end = consumed / RELEASE_CHUNK * RELEASE_CHUNK;
+  file_.release(released_bytes_, release_end - released_bytes_);
+  released_bytes_ = release_end;
+}
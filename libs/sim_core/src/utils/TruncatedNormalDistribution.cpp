@@ -0,0 +1,56 @@
+#include "sim/utils/TruncatedNormalDistribution.h"
+
+#include <cmath>
+#include <numbers>
+
+#include "sim/utils/Ziggurat.h"
+
+TruncatedNormalDistribution::TruncatedNormalDistribution(
+    double intensity, double shape, std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      cv_(shape) {
+  update();
+}
+
+double TruncatedNormalDistribution::generate() { return sample(); }
+
+void TruncatedNormalDistribution::fill(std::span<double> values) {
+  for (double& value : values) {
+    value = sample();
+  }
+}
+
+void TruncatedNormalDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void TruncatedNormalDistribution::set_shape(double shape) {
+  cv_ = shape;
+  update();
+}
+
+void TruncatedNormalDistribution::reseed(const StreamId& stream) {
+  RandomDistribution::reseed(stream);
+  bits_.clear();
+}
+
+// A normal with location m and scale cv * m, conditioned on being positive,
+// has mean m * (1 + cv * phi(1 / cv) / Phi(1 / cv))
+void TruncatedNormalDistribution::update() {
+  double z = 1.0 / cv_;
+  double density = std::exp(-0.5 * z * z) * 0.5 * std::numbers::inv_sqrtpi *
+                   std::numbers::sqrt2;
+  double probability = 0.5 * std::erfc(-z / std::numbers::sqrt2);
+  location_ = mean_ / (1.0 + cv_ * density / probability);
+  scale_ = cv_ * location_;
+}
+
+double TruncatedNormalDistribution::sample() {
+  double value;
+  do {
+    value = location_ + scale_ * Ziggurat::normal(bits_, *engine_);
+  } while (value <= 0.0);
+  return value;
+}
@@ -0,0 +1,35 @@
+#include "sim/utils/UniformDistribution.h"
+
+UniformDistribution::UniformDistribution(double intensity, double shape,
+                                         std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      half_width_(shape) {
+  update();
+}
+
+double UniformDistribution::generate() {
+  return low_ + width_ * engine_->next_uniform();
+}
+
+void UniformDistribution::fill(std::span<double> values) {
+  engine_->fill_uniform(values);
+  for (double& value : values) {
+    value = low_ + width_ * value;
+  }
+}
+
+void UniformDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void UniformDistribution::set_shape(double shape) {
+  half_width_ = shape;
+  update();
+}
+
+void UniformDistribution::update() {
+  low_ = mean_ * (1.0 - half_width_);
+  width_ = 2.0 * mean_ * half_width_;
+}
@@ -0,0 +1,257 @@
+#include "sim/utils/VectorMath.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIM_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIM_TARGET_AVX2
+#define SIM_TARGET_AVX512
+#else
+#define SIM_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIM_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+namespace {
+
+// fdlibm e_log.c
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LG1 = 6.666666666666735130e-01;
+constexpr double LG2 = 3.999999999940941908e-01;
+constexpr double LG3 = 2.857142874366239149e-01;
+constexpr double LG4 = 2.222219843214978396e-01;
+constexpr double LG5 = 1.818357216161805012e-01;
+constexpr double LG6 = 1.531383769920937332e-01;
+constexpr double LG7 = 1.479819860511658591e-01;
+
+constexpr double SQRT2 = 1.4142135623730951;
+constexpr double EXPONENT_BIAS = 1023.0;
+constexpr uint64_t MANTISSA_MASK = 0x000fffffffffffffull;
+constexpr uint64_t ONE_BITS = 0x3ff0000000000000ull;
+// OR-ing a small integer into the mantissa of 2^52 and subtracting 2^52
+// converts it to double exactly, which SIMD code can do without AVX-512DQ
+constexpr uint64_t TWO52_BITS = 0x4330000000000000ull;
+constexpr double TWO52 = 4503599627370496.0;
+
+// x = 2^e * m with m in (sqrt(2)/2, sqrt(2)], then
+// log(m) = f - hfsq + s * (hfsq + R(s^2)) with f = m - 1, s = f / (2 + f).
+// The SIMD kernels below spell out exactly these operations.
+double log_scaled_scalar(double x, double scale) {
+  uint64_t bits = std::bit_cast<uint64_t>(x);
+  double e = std::bit_cast<double>((bits >> 52) | TWO52_BITS) - TWO52;
+  e = e - EXPONENT_BIAS;
+  double m = std::bit_cast<double>((bits & MANTISSA_MASK) | ONE_BITS);
+  if (m > SQRT2) {
+    m = m * 0.5;
+    e = e + 1.0;
+  }
+
+  double f = m - 1.0;
+  double s = f / (2.0 + f);
+  double z = s * s;
+  double w = z * z;
+  double t1 = w * (LG2 + w * (LG4 + w * LG6));
+  double t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+  double r = t2 + t1;
+  double hfsq = 0.5 * f * f;
+  double log = e * LN2_HI - ((hfsq - (s * (hfsq + r) + e * LN2_LO)) - f);
+  return log * scale;
+}
+
+void log_scaled_scalar(double* values, size_t count, double scale) {
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = log_scaled_scalar(values[i], scale);
+  }
+}
+
+#ifdef SIM_X86_SIMD
+
+SIM_TARGET_AVX2 void log_scaled_avx2(double* values, size_t count,
+                                     double scale) {
+  const __m256i mantissa_mask =
+      _mm256_set1_epi64x(static_cast<long long>(MANTISSA_MASK));
+  const __m256i one_bits = _mm256_set1_epi64x(static_cast<long long>(ONE_BITS));
+  const __m256i two52_bits =
+      _mm256_set1_epi64x(static_cast<long long>(TWO52_BITS));
+  const __m256d two52 = _mm256_set1_pd(TWO52);
+  const __m256d bias = _mm256_set1_pd(EXPONENT_BIAS);
+  const __m256d sqrt2 = _mm256_set1_pd(SQRT2);
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d half = _mm256_set1_pd(0.5);
+  const __m256d scale_v = _mm256_set1_pd(scale);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i bits = _mm256_castpd_si256(_mm256_loadu_pd(values + i));
+    __m256d e = _mm256_sub_pd(
+        _mm256_castsi256_pd(
+            _mm256_or_si256(_mm256_srli_epi64(bits, 52), two52_bits)),
+        two52);
+    e = _mm256_sub_pd(e, bias);
+    __m256d m = _mm256_castsi256_pd(
+        _mm256_or_si256(_mm256_and_si256(bits, mantissa_mask), one_bits));
+    __m256d big = _mm256_cmp_pd(m, sqrt2, _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, half), big);
+    e = _mm256_add_pd(e, _mm256_and_pd(big, one));
+
+    __m256d f = _mm256_sub_pd(m, one);
+    __m256d s = _mm256_div_pd(f, _mm256_add_pd(two, f));
+    __m256d z = _mm256_mul_pd(s, s);
+    __m256d w = _mm256_mul_pd(z, z);
+    __m256d t1 = _mm256_mul_pd(
+        w, _mm256_add_pd(
+               _mm256_set1_pd(LG2),
+               _mm256_mul_pd(w, _mm256_add_pd(
+                                    _mm256_set1_pd(LG4),
+                                    _mm256_mul_pd(w, _mm256_set1_pd(LG6))))));
+    __m256d t2 = _mm256_mul_pd(
+        z, _mm256_add_pd(
+               _mm256_set1_pd(LG1),
+               _mm256_mul_pd(
+                   w, _mm256_add_pd(
+                          _mm256_set1_pd(LG3),
+                          _mm256_mul_pd(
+                              w, _mm256_add_pd(
+                                     _mm256_set1_pd(LG5),
+                                     _mm256_mul_pd(w, _mm256_set1_pd(LG7))))))));
+    __m256d r = _mm256_add_pd(t2, t1);
+    __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(half, f), f);
+    __m256d inner = _mm256_add_pd(
+        _mm256_mul_pd(s, _mm256_add_pd(hfsq, r)),
+        _mm256_mul_pd(e, _mm256_set1_pd(LN2_LO)));
+    __m256d log = _mm256_sub_pd(
+        _mm256_mul_pd(e, _mm256_set1_pd(LN2_HI)),
+        _mm256_sub_pd(_mm256_sub_pd(hfsq, inner), f));
+    _mm256_storeu_pd(values + i, _mm256_mul_pd(log, scale_v));
+  }
+  log_scaled_scalar(values + i, count - i, scale);
+}
+
+SIM_TARGET_AVX512 void log_scaled_avx512(double* values, size_t count,
+                                         double scale) {
+  const __m512d sqrt2 = _mm512_set1_pd(SQRT2);
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d two = _mm512_set1_pd(2.0);
+  const __m512d half = _mm512_set1_pd(0.5);
+  const __m512d scale_v = _mm512_set1_pd(scale);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    // Exact for normal inputs, so the same e and m as the bit fiddling.
+    // The all-lanes maskz forms avoid GCC's spurious undefined-source warning.
+    __m512d x = _mm512_loadu_pd(values + i);
+    __m512d e = _mm512_maskz_getexp_pd(0xFF, x);
+    __m512d m =
+        _mm512_maskz_getmant_pd(0xFF, x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+    __mmask8 big = _mm512_cmp_pd_mask(m, sqrt2, _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, big, m, half);
+    e = _mm512_mask_add_pd(e, big, e, one);
+
+    __m512d f = _mm512_sub_pd(m, one);
+    __m512d s = _mm512_div_pd(f, _mm512_add_pd(two, f));
+    __m512d z = _mm512_mul_pd(s, s);
+    __m512d w = _mm512_mul_pd(z, z);
+    __m512d t1 = _mm512_mul_pd(
+        w, _mm512_add_pd(
+               _mm512_set1_pd(LG2),
+               _mm512_mul_pd(w, _mm512_add_pd(
+                                    _mm512_set1_pd(LG4),
+                                    _mm512_mul_pd(w, _mm512_set1_pd(LG6))))));
+    __m512d t2 = _mm512_mul_pd(
+        z, _mm512_add_pd(
+               _mm512_set1_pd(LG1),
+               _mm512_mul_pd(
+                   w, _mm512_add_pd(
+                          _mm512_set1_pd(LG3),
+                          _mm512_mul_pd(
+                              w, _mm512_add_pd(
+                                     _mm512_set1_pd(LG5),
+                                     _mm512_mul_pd(w, _mm512_set1_pd(LG7))))))));
+    __m512d r = _mm512_add_pd(t2, t1);
+    __m512d hfsq = _mm512_mul_pd(_mm512_mul_pd(half, f), f);
+    __m512d inner = _mm512_add_pd(
+        _mm512_mul_pd(s, _mm512_add_pd(hfsq, r)),
+        _mm512_mul_pd(e, _mm512_set1_pd(LN2_LO)));
+    __m512d log = _mm512_sub_pd(
+        _mm512_mul_pd(e, _mm512_set1_pd(LN2_HI)),
+        _mm512_sub_pd(_mm512_sub_pd(hfsq, inner), f));
+    _mm512_storeu_pd(values + i, _mm512_mul_pd(log, scale_v));
+  }
+  log_scaled_scalar(values + i, count - i, scale);
+}
+
+SimdLevel detect_simd_level() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  if (max_leaf < 7 || !osxsave || !avx) {
+    return SimdLevel::Scalar;
+  }
+  // The OS must save the YMM (and for AVX-512 the opmask and ZMM) state
+  unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  if ((xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0) {
+    return SimdLevel::Avx512;
+  }
+  if ((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0) {
+    return SimdLevel::Avx2;
+  }
+  return SimdLevel::Scalar;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::Avx2;
+  }
+  return SimdLevel::Scalar;
+#endif
+}
+
+#else
+
+SimdLevel detect_simd_level() { return SimdLevel::Scalar; }
+
+#endif  // SIM_X86_SIMD
+
+}  // namespace
+
+SimdLevel VectorMath::get_simd_level() {
+  static const SimdLevel level = detect_simd_level();
+  return level;
+}
+
+void VectorMath::log_scaled(std::span<double> values, double scale) {
+  log_scaled(values, scale, get_simd_level());
+}
+
+void VectorMath::log_scaled(std::span<double> values, double scale,
+                            SimdLevel level) {
+  switch (std::min(level, get_simd_level())) {
+#ifdef SIM_X86_SIMD
+    case SimdLevel::Avx512:
+      log_scaled_avx512(values.data(), values.size(), scale);
+      break;
+    case SimdLevel::Avx2:
+      log_scaled_avx2(values.data(), values.size(), scale);
+      break;
+#endif
+    case SimdLevel::Scalar:
+    default:
+      log_scaled_scalar(values.data(), values.size(), scale);
+      break;
+  }
+}
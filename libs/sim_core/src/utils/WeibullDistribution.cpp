@@ -0,0 +1,43 @@
+#include "sim/utils/WeibullDistribution.h"
+
+#include <cmath>
+
+#include "sim/utils/VectorMath.h"
+
+WeibullDistribution::WeibullDistribution(double intensity, double shape,
+                                         std::unique_ptr<IRandomEngine> engine)
+    : RandomDistribution(std::move(engine)),
+      mean_(1.0 / intensity),
+      k_(shape) {
+  update();
+}
+
+double WeibullDistribution::generate() {
+  double value;
+  fill(std::span<double>(&value, 1));
+  return value;
+}
+
+void WeibullDistribution::fill(std::span<double> values) {
+  engine_->fill_uniform(values);
+  VectorMath::log_scaled(values, -1.0);
+  double exponent = 1.0 / k_;
+  for (double& value : values) {
+    value = scale_ * std::pow(value, exponent);
+  }
+}
+
+void WeibullDistribution::set_parameter(double param) {
+  mean_ = 1.0 / param;
+  update();
+}
+
+void WeibullDistribution::set_shape(double shape) {
+  k_ = shape;
+  update();
+}
+
+// The mean of Weibull(scale, k) is scale * Gamma(1 + 1 / k)
+void WeibullDistribution::update() {
+  scale_ = mean_ / std::tgamma(1.0 + 1.0 / k_);
+}
@@ -0,0 +1,139 @@
+#include "sim/utils/Ziggurat.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+constexpr size_t LAYERS = 256;
+
+// x[0] is the width of a rectangle with the area of the base layer (the
+// strip below f(R) plus the tail), x[1] = R, and every layer above has the
+// same area V; f[i] = f(x[i])
+struct Table {
+  std::array<double, LAYERS + 1> x;
+  std::array<double, LAYERS + 1> f;
+};
+
+template <class Density, class InverseDensity>
+Table make_table(double r, double v, Density density,
+                 InverseDensity inverse_density) {
+  Table table;
+  table.x[0] = v / density(r);
+  table.x[1] = r;
+  for (size_t i = 1; i < LAYERS - 1; ++i) {
+    table.x[i + 1] = inverse_density(v / table.x[i] + density(table.x[i]));
+  }
+  table.x[LAYERS] = 0.0;
+  for (size_t i = 0; i <= LAYERS; ++i) {
+    table.f[i] = density(table.x[i]);
+  }
+  return table;
+}
+
+double normal_density(double x) { return std::exp(-0.5 * x * x); }
+double exponential_density(double x) { return std::exp(-x); }
+
+const double NORMAL_R = 3.6541528853610088;
+const double EXPONENTIAL_R = 7.69711747013104972;
+
+const Table NORMAL_TABLE = make_table(
+    NORMAL_R, 0.00492867323399, normal_density,
+    [](double y) { return std::sqrt(-2.0 * std::log(y)); });
+
+const Table EXPONENTIAL_TABLE = make_table(
+    EXPONENTIAL_R, 0.0039496598225815571993, exponential_density,
+    [](double y) { return -std::log(y); });
+
+// Low 8 bits of a word pick the layer, bit 8 the sign and the top 53 bits
+// the position within the layer
+size_t layer_of(uint64_t word) { return static_cast<size_t>(word & 0xff); }
+bool negative(uint64_t word) { return (word & 0x100) != 0; }
+double position_of(uint64_t word) {
+  return static_cast<double>(word >> 11) * 0x1.0p-53;
+}
+
+double normal_slow(uint64_t word, BitBlock& bits, IRandomEngine& engine) {
+  const Table& t = NORMAL_TABLE;
+  while (true) {
+    size_t i = layer_of(word);
+    double x = position_of(word) * t.x[i];
+    if (x < t.x[i + 1]) {
+      return negative(word) ? -x : x;
+    }
+    if (i == 0) {
+      // Marsaglia's tail method beyond R
+      double tail;
+      double y;
+      do {
+        tail = -std::log(bits.next_uniform(engine)) / NORMAL_R;
+        y = -std::log(bits.next_uniform(engine));
+      } while (y + y < tail * tail);
+      return negative(word) ? -(NORMAL_R + tail) : NORMAL_R + tail;
+    }
+    if (t.f[i] + bits.next_uniform(engine) * (t.f[i + 1] - t.f[i]) <
+        normal_density(x)) {
+      return negative(word) ? -x : x;
+    }
+    word = bits.next(engine);
+  }
+}
+
+double exponential_slow(uint64_t word, BitBlock& bits,
+                        IRandomEngine& engine) {
+  const Table& t = EXPONENTIAL_TABLE;
+  while (true) {
+    size_t i = layer_of(word);
+    double x = position_of(word) * t.x[i];
+    if (x < t.x[i + 1]) {
+      return x;
+    }
+    if (i == 0) {
+      // The tail beyond R is R plus a fresh exponential
+      return EXPONENTIAL_R - std::log(bits.next_uniform(engine));
+    }
+    if (t.f[i] + bits.next_uniform(engine) * (t.f[i + 1] - t.f[i]) <
+        exponential_density(x)) {
+      return x;
+    }
+    word = bits.next(engine);
+  }
+}
+
+}  // namespace
+
+double Ziggurat::normal(BitBlock& bits, IRandomEngine& engine) {
+  uint64_t word = bits.next(engine);
+  size_t i = layer_of(word);
+  double x = position_of(word) * NORMAL_TABLE.x[i];
+  if (x < NORMAL_TABLE.x[i + 1]) {
+    return negative(word) ? -x : x;
+  }
+  return normal_slow(word, bits, engine);
+}
+
+void Ziggurat::fill_normal(std::span<double> values, BitBlock& bits,
+                           IRandomEngine& engine) {
+  for (double& value : values) {
+    value = normal(bits, engine);
+  }
+}
+
+double Ziggurat::exponential(BitBlock& bits, IRandomEngine& engine) {
+  uint64_t word = bits.next(engine);
+  size_t i = layer_of(word);
+  double x = position_of(word) * EXPONENTIAL_TABLE.x[i];
+  if (x < EXPONENTIAL_TABLE.x[i + 1]) {
+    return x;
+  }
+  return exponential_slow(word, bits, engine);
+}
+
+void Ziggurat::fill_exponential(std::span<double> values, BitBlock& bits,
+                                IRandomEngine& engine) {
+  for (double& value : values) {
+    value = exponential(bits, engine);
+  }
+}